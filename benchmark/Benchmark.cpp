@@ -0,0 +1,532 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <omp.h>
+
+#include "../helper/PointHelper.h"
+
+std::vector<std::pair<int, int>> Benchmark::randomQueries(const DynamicGraph &graph, const int count) {
+    // Semente fixa para que as consultas sejam as mesmas entre execuções
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dist(0, graph.getNetwork().getNumNodes() - 1);
+
+    std::vector<std::pair<int, int>> queries;
+    queries.reserve(count);
+
+    while (static_cast<int>(queries.size()) < count) {
+        const int u = dist(gen);
+        const int v = dist(gen);
+        if (u != v) queries.emplace_back(u, v);
+    }
+
+    return queries;
+}
+
+void Benchmark::reportLayout(const DynamicGraph &graph) {
+    const RoadNetwork &network = graph.getNetwork();
+    const std::size_t numNodes = network.getNumNodes();
+    const std::size_t numEdges = network.getNumEdges();
+
+    // Estimativa do layout anterior (unordered_map<long long, Point> + unordered_map<long long, std::list<Edge>>)
+    // Cada nó de tabela ou de lista ocupa 48 bytes após o arredondamento do alocador, mais um bucket por vértice
+    const std::size_t legacyBytes = numNodes * (48 + sizeof(void*)) * 2 + numEdges * 48;
+
+    std::cout << "Vertices: " << numNodes << " | Arestas: " << numEdges << '\n';
+    std::cout << "Memoria CSR: " << network.memoryUsage() / 1024.0 << " KiB\n";
+    std::cout << "Memoria estimada (hash + listas): " << legacyBytes / 1024.0 << " KiB\n";
+}
+
+double Benchmark::pathDistance(const RoadNetwork &network, const int source, const std::vector<int> &path) {
+    double total = 0.0;
+    int previous = source;
+
+    for (const int node : path) {
+        total += network.getEdgeWeight(network.findEdge(previous, node));
+        previous = node;
+    }
+
+    return total;
+}
+
+void Benchmark::reportGrid(const DynamicGraph &graph) {
+    const UniformGrid &grid = graph.getUniformGrid();
+
+    // Tabela hash equivalente ao layout anterior (uma lista por célula), com as mesmas listas da grade
+    std::unordered_map<Cell, std::vector<int>, Cell::Hash> hashGrid;
+    std::size_t hashBytes = 0;
+    for (const Cell &cell : grid.getNonEmptyCells()) {
+        const int list = grid.getCellList(cell);
+        std::vector<int> &edges = hashGrid[cell];
+        for (int pos = grid.beginList(list); pos < grid.endList(list); pos++) edges.push_back(grid.getListEdge(pos));
+        hashBytes += edges.capacity() * sizeof(int);
+    }
+    // Nó da tabela (próximo + chave + vetor + hash) e um bucket por célula
+    hashBytes += hashGrid.size() * (sizeof(void*) + sizeof(Cell) + sizeof(std::vector<int>) + sizeof(std::size_t)) +
+                 hashGrid.bucket_count() * sizeof(void*);
+
+    // Células sorteadas na caixa do mapa com uma borda (parte delas sem arestas ou fora da grade)
+    std::mt19937 gen(42);
+    const double cellSize = grid.getCellSize();
+    std::uniform_int_distribution<> distI(static_cast<int>(std::floor(graph.getMinLon() / cellSize)) - 2,
+                                          static_cast<int>(std::floor(graph.getMaxLon() / cellSize)) + 2);
+    std::uniform_int_distribution<> distJ(static_cast<int>(std::floor(graph.getMinLat() / cellSize)) - 2,
+                                          static_cast<int>(std::floor(graph.getMaxLat() / cellSize)) + 2);
+
+    std::vector<Cell> cells;
+    for (int i = 0; i < 1000000; i++) cells.emplace_back(distI(gen), distJ(gen));
+
+    long long hashSum = 0;
+    const auto hashStart = std::chrono::high_resolution_clock::now();
+    for (const Cell &cell : cells) {
+        if (const auto it = hashGrid.find(cell); it != hashGrid.end()) {
+            for (const int edge : it->second) hashSum += edge;
+        }
+    }
+    const auto denseStart = std::chrono::high_resolution_clock::now();
+    long long denseSum = 0;
+    for (const Cell &cell : cells) {
+        const int list = grid.getCellList(cell);
+        if (list < 0 || !grid.hasEdges(cell)) continue;
+        for (int pos = grid.beginList(list); pos < grid.endList(list); pos++) denseSum += grid.getListEdge(pos);
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Grade: celula " << cellSize << " graus | " << grid.getNumSplitBlocks() << " de " << grid.getNumBlocks()
+              << " blocos divididos, " << grid.getNumLists() << " listas, " << grid.getNumEntries() << " entradas\n";
+    std::cout << "Grade: " << grid.getNonEmptyCells().size() << " de " << grid.getNumCells() << " celulas com arestas | "
+              << "hash " << std::chrono::duration<double, std::nano>(denseStart - hashStart).count() / cells.size()
+              << " ns, " << hashBytes / 1024.0 << " KiB | blocos "
+              << std::chrono::duration<double, std::nano>(end - denseStart).count() / cells.size() << " ns, "
+              << grid.memoryUsage() / 1024.0 << " KiB" << (hashSum == denseSum ? "" : " | RESULTADOS DIFERENTES") << '\n';
+}
+
+void Benchmark::reportObstacleCandidates(DynamicGraph &graph) {
+    const RoadNetwork &network = graph.getNetwork();
+
+    // Grade com as arestas em todas as células da caixa delimitadora (inserção anterior)
+    UniformGrid boxGrid(graph.getUniformGrid().getCellSize());
+    for (int e = 0; e < network.getNumEdges(); e++) {
+        boxGrid.insertEdgeBoundingBox(e, network.getPoint(network.getEdgeSource(e)), network.getPoint(network.getEdgeTarget(e)));
+    }
+    boxGrid.finalize();
+
+    long long boxEdges = 0;
+    long long exactEdges = 0;
+    long long exactSegmentTests = 0;
+    long long crossingEdges = 0;
+    int different = 0;
+
+    ObstacleSnapshot boxSnapshot;
+    for (int tick = 0; tick < numTicks; tick++) {
+        graph.updatePolygonsPosition();
+        boxSnapshot.rebuild(network, boxGrid, graph.getPolygonBatch(), graph.getPolygonIndex());
+
+        const ObstacleSnapshot &exact = graph.getObstacleSnapshot();
+        boxEdges += boxSnapshot.getCandidateEdges();
+        exactEdges += exact.getCandidateEdges();
+        exactSegmentTests += exact.getSegmentTests();
+
+        // Arestas bloqueadas apenas por atravessar um polígono
+        for (const int edge : exact.getBlockedEdges()) {
+            crossingEdges += !exact.isNodeBlocked(network.getEdgeSource(edge)) && !exact.isNodeBlocked(network.getEdgeTarget(edge));
+            different += !boxSnapshot.isEdgeBlocked(edge);
+        }
+        different += boxSnapshot.getBlockedEdges().size() != exact.getBlockedEdges().size();
+    }
+
+    const UniformGrid &grid = graph.getUniformGrid();
+    std::cout << "Insercao na grade: caixa " << boxGrid.getNumEntries() << " entradas, " << static_cast<double>(boxEdges) / numTicks
+              << " arestas candidatas/fotografia | percurso " << grid.getNumEntries() << " entradas, "
+              << static_cast<double>(exactEdges) / numTicks << " arestas candidatas/fotografia\n";
+    std::cout << "Bloqueio por segmento: " << static_cast<double>(exactSegmentTests) / numTicks << " testes/fotografia | "
+              << static_cast<double>(crossingEdges) / numTicks << " arestas atravessando sem extremidade dentro | "
+              << different << " diferencas entre as grades\n";
+}
+
+void Benchmark::reportPolygonTests(const DynamicGraph &graph, const double polygonRadius) {
+    const RoadNetwork &network = graph.getNetwork();
+    const int numNodes = network.getNumNodes();
+
+    std::vector<double> xs(numNodes);
+    std::vector<double> ys(numNodes);
+    for (int node = 0; node < numNodes; node++) {
+        xs[node] = network.getX(node);
+        ys[node] = network.getY(node);
+    }
+
+    // Todos os vértices contra todos os polígonos: escalar, um ponto x polígonos e pontos x um polígono
+    for (const int count : {5, 15, 50, 500}) {
+        std::vector<Hexagon> polygons;
+        Philox placement(graph.getSeed(), Philox::PolygonPlacement, graph.getTrial(), count);
+        for (int i = 0; i < count; i++) polygons.push_back(Hexagon::generateInGrid(graph.getUniformGrid(), polygonRadius, placement));
+
+        PolygonBatch batch;
+        batch.assign(polygons);
+
+        std::vector<std::uint8_t> scalarInside(static_cast<std::size_t>(numNodes) * count);
+        std::vector<std::uint8_t> pointInside(scalarInside.size());
+        std::vector<std::uint8_t> polygonInside(scalarInside.size());
+
+        const auto scalarStart = std::chrono::high_resolution_clock::now();
+        for (int node = 0; node < numNodes; node++) {
+            for (int p = 0; p < count; p++) {
+                scalarInside[static_cast<std::size_t>(node) * count + p] =
+                    polygons[p].containsPoint(xs[node], ys[node]);
+            }
+        }
+        const auto pointStart = std::chrono::high_resolution_clock::now();
+        for (int node = 0; node < numNodes; node++) {
+            batch.containsPoint(xs[node], ys[node], pointInside.data() + static_cast<std::size_t>(node) * count);
+        }
+        const auto polygonStart = std::chrono::high_resolution_clock::now();
+        for (int p = 0; p < count; p++) {
+            batch.containsPoints(p, xs.data(), ys.data(), numNodes, polygonInside.data() + static_cast<std::size_t>(p) * numNodes);
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        // pointInside é indexado por vértice e polygonInside por polígono
+        int different = 0;
+        for (int node = 0; node < numNodes; node++) {
+            for (int p = 0; p < count; p++) {
+                const std::uint8_t expected = scalarInside[static_cast<std::size_t>(node) * count + p];
+                different += expected != pointInside[static_cast<std::size_t>(node) * count + p] ||
+                             expected != polygonInside[static_cast<std::size_t>(p) * numNodes + node];
+            }
+        }
+
+        const double tests = static_cast<double>(numNodes) * count;
+        std::cout << "Ponto-poligono (" << count << " poligonos): escalar "
+                  << std::chrono::duration<double, std::nano>(pointStart - scalarStart).count() / tests << " ns | ponto x poligonos "
+                  << std::chrono::duration<double, std::nano>(polygonStart - pointStart).count() / tests << " ns | pontos x poligono "
+                  << std::chrono::duration<double, std::nano>(end - polygonStart).count() / tests << " ns | "
+                  << different << " diferentes\n";
+    }
+}
+
+void Benchmark::reportQueries(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries) {
+    std::size_t found = 0;
+    std::size_t touched = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto &[u, v] : queries) {
+        found += !graph.findPathAStar(u, v).empty();
+        touched += DynamicGraph::getSearchContext().getTouched().size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const double staticUs = std::chrono::duration<double, std::micro>(end - start).count() / queries.size();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (const auto &[u, v] : queries) {
+        graph.findPathAStarConsideringPolygons(u, v);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    const double dynamicUs = std::chrono::duration<double, std::micro>(end - start).count() / queries.size();
+
+    std::cout << "Consultas: " << queries.size() << " (" << found << " com caminho)\n";
+    std::cout << "A* sem poligonos: " << staticUs << " us/consulta | "
+              << static_cast<double>(touched) / queries.size() << " vertices tocados/consulta\n";
+    std::cout << "A* com poligonos: " << dynamicUs << " us/consulta\n";
+}
+
+void Benchmark::reportHeuristics(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries) {
+    const RoadNetwork &network = graph.getNetwork();
+    constexpr int repetitions = 200;
+
+    // Custo de cada forma da heurística nos mesmos pares (o acumulado impede que o laço seja descartado)
+    double checksum = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repetitions; r++) {
+        for (const auto &[u, v] : queries) checksum += PointHelper::haversineDistance(network.getPoint(u), network.getPoint(v));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const double pointNs = std::chrono::duration<double, std::nano>(end - start).count() / (repetitions * queries.size());
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repetitions; r++) {
+        for (const auto &[u, v] : queries) checksum += network.haversineDistance(u, v);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    const double tableNs = std::chrono::duration<double, std::nano>(end - start).count() / (repetitions * queries.size());
+
+    std::vector<int> sources;
+    for (const auto &[u, v] : queries) sources.push_back(u);
+    std::vector<double> out(sources.size());
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repetitions; r++) {
+        network.chordDistances(sources.data(), static_cast<int>(sources.size()), queries[r].second, out.data());
+        checksum += out[r];
+    }
+    end = std::chrono::high_resolution_clock::now();
+    const double chordNs = std::chrono::duration<double, std::nano>(end - start).count() / (repetitions * queries.size());
+
+    std::cout << "Heuristica: haversine " << pointNs << " ns | haversine (tabela) " << tableNs
+              << " ns | corda (lote) " << chordNs << " ns" << (checksum < 0 ? " " : "") << '\n';
+
+    // A* com cada heurística nas mesmas consultas (a corda é menor ou igual, então os caminhos continuam ótimos)
+    const DynamicGraph::GeometricHeuristic heuristics[] = {DynamicGraph::Haversine, DynamicGraph::Chord};
+    const char *names[] = {"haversine", "corda"};
+    std::vector<std::vector<int>> paths[2];
+
+    for (int h = 0; h < 2; h++) {
+        graph.setGeometricHeuristic(heuristics[h]);
+
+        std::size_t settled = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (const auto &[u, v] : queries) {
+            paths[h].push_back(graph.findPathAStar(u, v));
+            settled += DynamicGraph::getSearchContext().getSettled();
+        }
+        end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "A* (" << names[h] << "): " << std::chrono::duration<double, std::micro>(end - start).count() / queries.size()
+                  << " us/consulta | " << static_cast<double>(settled) / queries.size() << " vertices expandidos/consulta\n";
+    }
+
+    // Caminhos iguais vértice a vértice (empates podem trocar o caminho sem mudar a distância)
+    int differentPaths = 0;
+    int differentDistances = 0;
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        differentPaths += paths[0][i] != paths[1][i];
+        differentDistances += std::abs(pathDistance(network, queries[i].first, paths[0][i]) -
+                                       pathDistance(network, queries[i].first, paths[1][i])) > 1e-6;
+    }
+    std::cout << "Corda x haversine: " << differentPaths << " caminhos diferentes, " << differentDistances
+              << " distancias divergentes\n";
+
+    graph.setGeometricHeuristic(DynamicGraph::Haversine);
+}
+
+void Benchmark::reportQueues(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries) {
+    // Mesmas consultas (sem polígonos) com cada fila de prioridade nas duas variantes do A*
+    const SearchContext::QueueType queues[] = {
+        SearchContext::BinaryHeap, SearchContext::QuaternaryHeap, SearchContext::RadixHeap
+    };
+    const char *names[] = {"heap binario", "heap 4-ario", "radix heap"};
+    // Caminhos do heap binário (mesma ordem de remoção da priority_queue original) para comparar vértice a vértice
+    std::vector<std::vector<int>> binaryPaths;
+
+    for (int q = 0; q < 3; q++) {
+        graph.setSearchQueues(queues[q], queues[q]);
+
+        long long pushes = 0;
+        int differentPaths = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < queries.size(); i++) {
+            std::vector<int> path = graph.findPathAStar(queries[i].first, queries[i].second);
+            pushes += DynamicGraph::getSearchContext().getPushes();
+
+            if (q == 0) binaryPaths.push_back(std::move(path));
+            else differentPaths += path != binaryPaths[i];
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        const double unidirectionalUs = std::chrono::duration<double, std::micro>(end - start).count() / queries.size();
+
+        start = std::chrono::high_resolution_clock::now();
+        for (const auto &[u, v] : queries) {
+            graph.findPathAStar(u, v, DynamicGraph::AltAStar);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        const double altUs = std::chrono::duration<double, std::micro>(end - start).count() / queries.size();
+
+        start = std::chrono::high_resolution_clock::now();
+        for (const auto &[u, v] : queries) {
+            graph.findPathAStar(u, v, DynamicGraph::BidirectionalAStar);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        const double bidirectionalUs = std::chrono::duration<double, std::micro>(end - start).count() / queries.size();
+
+        std::cout << "Fila " << names[q] << ": A* " << unidirectionalUs << " us/consulta ("
+                  << static_cast<double>(pushes) / queries.size() << " insercoes) | A* ALT " << altUs
+                  << " us/consulta | A* bidirecional " << bidirectionalUs << " us/consulta | "
+                  << differentPaths << " caminhos do A* diferentes do heap binario\n";
+    }
+
+    // Volta para a escolha padrão de cada busca
+    graph.setSearchQueues(SearchContext::RadixHeap, SearchContext::QuaternaryHeap);
+}
+
+void Benchmark::reportHierarchy(DynamicGraph &graph) {
+    graph.prepareContractionHierarchy();
+
+    const ContractionHierarchy &hierarchy = graph.getContractionHierarchy();
+    std::cout << "CCH: " << hierarchy.getNumArcs() << " arcos, " << hierarchy.getNumTriangles() << " triangulos | "
+              << "pre-processamento " << graph.getHierarchyBuildUs() / 1000.0 << " ms\n";
+
+    // Movimenta os polígonos para medir a recustomização parcial por tick
+    for (int tick = 0; tick < numTicks; tick++) {
+        graph.updatePolygonsPosition();
+        graph.applyPendingCustomization();
+    }
+
+    std::cout << "CCH: recustomizacao media " << graph.getAverageCustomizationUs() << " us/tick\n";
+}
+
+void Benchmark::reportLandmarks(DynamicGraph &graph) {
+    // Usa as tabelas já carregadas (linha de comando) ou seleciona a quantidade padrão
+    if (!graph.getLandmarks().isReady()) {
+        graph.prepareLandmarks();
+    }
+
+    const Landmarks &landmarks = graph.getLandmarks();
+    std::cout << "ALT: " << landmarks.getNumLandmarks() << " landmarks | pre-processamento "
+              << graph.getLandmarksBuildUs() / 1000.0 << " ms | " << landmarks.memoryUsage() / 1024.0 << " KiB\n";
+}
+
+void Benchmark::reportAlgorithms(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries) {
+    // Compara os algoritmos nas mesmas viagens (considerando os polígonos)
+    const DynamicGraph::SearchAlgorithm algorithms[] = {
+        DynamicGraph::AStar, DynamicGraph::AltAStar, DynamicGraph::BidirectionalAStar, DynamicGraph::ContractionHierarchies
+    };
+    const char *names[] = {"A* unidirecional", "A* ALT", "A* bidirecional", "CCH"};
+    constexpr int numAlgorithms = 4;
+    std::vector<double> distances[numAlgorithms];
+
+    for (int a = 0; a < numAlgorithms; a++) {
+        std::size_t settled = 0;
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (const auto &[u, v] : queries) {
+            const std::vector<int> path = graph.findPathAStarConsideringPolygons(u, v, algorithms[a]);
+            distances[a].push_back(pathDistance(graph.getNetwork(), u, path));
+
+            if (algorithms[a] != DynamicGraph::ContractionHierarchies) {
+                settled += DynamicGraph::getSearchContext(0).getSettled();
+            }
+            if (algorithms[a] == DynamicGraph::BidirectionalAStar) {
+                settled += DynamicGraph::getSearchContext(1).getSettled();
+            }
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << names[a] << ": " << std::chrono::duration<double, std::micro>(end - start).count() / queries.size() << " us/consulta";
+        if (algorithms[a] != DynamicGraph::ContractionHierarchies) {
+            std::cout << " | " << static_cast<double>(settled) / queries.size() << " vertices expandidos/consulta";
+        }
+        std::cout << '\n';
+    }
+
+    // Todas as variantes são exatas, as distâncias devem coincidir com o A*
+    for (int a = 1; a < numAlgorithms; a++) {
+        int different = 0;
+        for (std::size_t i = 0; i < queries.size(); i++) {
+            if (std::abs(distances[0][i] - distances[a][i]) > 1e-6) different++;
+        }
+
+        std::cout << "Distancias divergentes (" << names[a] << "): " << different << '\n';
+    }
+}
+
+void Benchmark::reportBatch(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries) {
+    // Vazão das consultas em lote (com polígonos) conforme a quantidade de threads
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < omp_get_max_threads(); threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(omp_get_max_threads());
+
+    const DynamicGraph::SearchAlgorithm algorithms[] = {DynamicGraph::AStar, DynamicGraph::AltAStar, DynamicGraph::ContractionHierarchies};
+    const char *names[] = {"A*", "A* ALT", "CCH"};
+
+    for (int a = 0; a < 3; a++) {
+        std::vector<std::vector<int>> sequential;
+
+        for (const int threads : threadCounts) {
+            const auto start = std::chrono::high_resolution_clock::now();
+            const auto paths = graph.findPaths(queries, true, algorithms[a], threads);
+            const auto end = std::chrono::high_resolution_clock::now();
+
+            // As respostas não podem depender da quantidade de threads
+            if (sequential.empty()) sequential = paths;
+            int different = 0;
+            for (std::size_t i = 0; i < paths.size(); i++) different += paths[i] != sequential[i];
+
+            const double seconds = std::chrono::duration<double>(end - start).count();
+            std::cout << "Lote " << names[a] << " (" << threads << " threads): "
+                      << queries.size() / seconds << " consultas/s | " << different << " caminhos diferentes\n";
+        }
+    }
+}
+
+void Benchmark::reportDistanceMatrix(DynamicGraph &graph) {
+    const RoadNetwork &network = graph.getNetwork();
+
+    DistanceMatrix matrix;
+    Philox rng(graph.getSeed(), Philox::NodeSample, 0);
+    const long long matrixUs = graph.computeDistanceMatrix(DistanceMatrix::sampleNodes(network, numMatrixNodes, rng), matrix);
+    const double pairs = static_cast<double>(matrix.size()) * matrix.size();
+
+    // Confere algumas linhas contra o A* ponto a ponto (sem polígonos)
+    int different = 0;
+    const int rows = std::min(numMatrixCheckRows, matrix.size());
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < matrix.size(); j++) {
+            if (i == j) continue;
+
+            const std::vector<int> path = graph.findPathAStar(matrix.getNode(i), matrix.getNode(j));
+            const double expected = path.empty() ? INFINITY : pathDistance(network, matrix.getNode(i), path);
+
+            if (std::isinf(expected) != !matrix.isReachable(i, j) ||
+                (std::isfinite(expected) && std::abs(expected - matrix.getDistance(i, j)) > 1e-3 * (1.0 + expected))) {
+                different++;
+            }
+        }
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const double aStarUs = std::chrono::duration<double, std::micro>(end - start).count() / (rows * (matrix.size() - 1));
+
+    std::cout << "Matriz " << matrix.size() << 'x' << matrix.size() << ": " << matrixUs / 1000.0 << " ms ("
+              << matrixUs / pairs << " us/par) | A*: " << aStarUs << " us/par | "
+              << different << " distancias diferentes\n";
+}
+
+void Benchmark::reportRouteCache(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries) {
+    graph.setRouteCacheEnabled(true);
+
+    // Primeira rodada calcula, a segunda repete as mesmas consultas e a terceira parte do meio dos caminhos
+    std::vector<std::vector<int>> paths;
+    for (const auto &[u, v] : queries) paths.push_back(graph.findPathAStarConsideringPolygons(u, v));
+    for (const auto &[u, v] : queries) graph.findPathAStarConsideringPolygons(u, v);
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        if (paths[i].size() > 2) graph.findPathAStarConsideringPolygons(paths[i][paths[i].size() / 2 - 1], queries[i].second);
+    }
+
+    const RouteCache::Stats &stats = graph.getRouteCacheStats();
+    std::cout << "Cache de rotas: " << stats.hits << " acertos, " << stats.suffixHits << " acertos por sufixo, "
+              << stats.misses << " falhas | " << stats.savedUs / 1000.0 << " ms economizados\n";
+
+    graph.setRouteCacheEnabled(false);
+}
+
+void Benchmark::run(DynamicGraph &graph, const int numPolygons, const double polygonRadius) {
+    // As medições repetem as mesmas consultas, a cache só é ligada no relatório dela
+    graph.setRouteCacheEnabled(false);
+
+    graph.clearPolygons();
+    Philox placement(graph.getSeed(), Philox::PolygonPlacement, graph.getTrial());
+    for (int i = 0; i < numPolygons; i++) {
+        graph.addPolygon(Hexagon::generateInGrid(graph.getUniformGrid(), polygonRadius, placement));
+    }
+
+    const auto queries = randomQueries(graph, numQueries);
+
+    reportLayout(graph);
+    reportGrid(graph);
+    reportObstacleCandidates(graph);
+    reportPolygonTests(graph, polygonRadius);
+    reportQueries(graph, queries);
+    reportHeuristics(graph, queries);
+    reportQueues(graph, queries);
+    reportHierarchy(graph);
+    reportLandmarks(graph);
+    reportAlgorithms(graph, queries);
+    reportBatch(graph, queries);
+    reportDistanceMatrix(graph);
+    reportRouteCache(graph, queries);
+}
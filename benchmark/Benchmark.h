@@ -0,0 +1,39 @@
+#ifndef PROJETOCONCLUSAOCURSO_BENCHMARK_H
+#define PROJETOCONCLUSAOCURSO_BENCHMARK_H
+#include <utility>
+#include <vector>
+
+#include "../graph/DynamicGraph.h"
+
+
+// Medições de desempenho das estruturas do grafo (modo "benchmark")
+class Benchmark {
+    static constexpr int numQueries = 1000;
+    static constexpr int numTicks = 200;
+    static constexpr int numMatrixNodes = 500;
+    static constexpr int numMatrixCheckRows = 10;
+
+    static std::vector<std::pair<int, int>> randomQueries(const DynamicGraph &graph, int count);
+
+    static void reportLayout(const DynamicGraph &graph);
+    static double pathDistance(const RoadNetwork &network, int source, const std::vector<int> &path);
+
+    static void reportGrid(const DynamicGraph &graph);
+    static void reportObstacleCandidates(DynamicGraph &graph);
+    static void reportPolygonTests(const DynamicGraph &graph, double polygonRadius);
+    static void reportQueries(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries);
+    static void reportHeuristics(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries);
+    static void reportQueues(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries);
+    static void reportHierarchy(DynamicGraph &graph);
+    static void reportLandmarks(DynamicGraph &graph);
+    static void reportAlgorithms(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries);
+    static void reportBatch(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries);
+    static void reportDistanceMatrix(DynamicGraph &graph);
+    static void reportRouteCache(DynamicGraph &graph, const std::vector<std::pair<int, int>> &queries);
+
+public:
+    static void run(DynamicGraph &graph, int numPolygons, double polygonRadius);
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_BENCHMARK_H
@@ -4,6 +4,7 @@
 
 #ifndef PROJETOCONCLUSAOCURSO_CELL_H
 #define PROJETOCONCLUSAOCURSO_CELL_H
+#include <cstdint>
 #include <functional>
 
 
@@ -26,7 +27,10 @@ public:
     class Hash {
     public:
         std::size_t operator()(const Cell& c) const {
-            return std::hash<int>()(c.i) ^ (std::hash<int>()(c.j) << 1);
+            // i e j em metades distintas de 64 bits (hash(i) ^ (hash(j) << 1) colide entre células vizinhas)
+            const std::uint64_t key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(c.i)) << 32) |
+                                      static_cast<std::uint32_t>(c.j);
+            return std::hash<std::uint64_t>()(key * 0x9E3779B97F4A7C15ULL);
         }
     };
 };
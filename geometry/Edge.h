@@ -4,20 +4,19 @@
 
 #ifndef PROJETOCONCLUSAOCURSO_EDGE_H
 #define PROJETOCONCLUSAOCURSO_EDGE_H
-#include "Point.h"
 
 
 class Edge {
-    Point* u;
-    Point* v;
+    int u;          // Índice denso do vértice de origem
+    int v;          // Índice denso do vértice de destino
     double dist;    // Distância em metros
 
 public:
-    Edge() : u(nullptr), v(nullptr), dist(0.0) {}
-    Edge(Point* u, Point* v, const double dist) : u(u), v(v), dist(dist) {}
+    Edge() : u(-1), v(-1), dist(0.0) {}
+    Edge(const int u, const int v, const double dist) : u(u), v(v), dist(dist) {}
 
-    Point* getU() const { return this->u; }
-    Point* getV() const { return this->v; }
+    int getU() const { return this->u; }
+    int getV() const { return this->v; }
     double getDist() const { return this->dist; }
 };
 
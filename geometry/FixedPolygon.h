@@ -0,0 +1,148 @@
+#ifndef PROJETOCONCLUSAOCURSO_FIXED_POLYGON_H
+#define PROJETOCONCLUSAOCURSO_FIXED_POLYGON_H
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "UniformGrid.h"
+#include "../helper/Philox.h"
+#include "../helper/PointHelper.h"
+
+
+// Polígono convexo (sentido anti-horário) com N vértices conhecidos em tempo de compilação, sem alocação
+// Os vértices são guardados relativos ao centro e nunca mudam: mover o polígono é apenas transladar o centro.
+// A caixa delimitadora também é relativa ao centro, então as coordenadas absolutas (centro + deslocamento)
+// dos vértices e da caixa são sempre consistentes entre si
+template <int N>
+class FixedPolygon {
+    static_assert(N >= 3, "Um polígono precisa de pelo menos três vértices");
+
+    std::array<double, N> offsetX{};        // Vértice k = centro + (offsetX[k], offsetY[k])
+    std::array<double, N> offsetY{};
+    double centerX = 0.0;
+    double centerY = 0.0;
+    double minOffsetX = 0.0;                // Caixa delimitadora relativa ao centro
+    double maxOffsetX = 0.0;
+    double minOffsetY = 0.0;
+    double maxOffsetY = 0.0;
+    double velocityX = 0.0;
+    double velocityY = 0.0;
+    bool valid = false;                     // Polígono padrão (sem vértices) nunca contém pontos
+    // Controla o movimento do polígono (via mouse)
+    bool isDraggable = false;
+    bool isBeingDragged = false;
+
+public:
+    static constexpr int numVertices = N;
+    static constexpr double inertia = 0.8;
+    static constexpr double acceleration = 0.5;
+    static constexpr double maxMoveDistance = 0.00009;
+
+    FixedPolygon() = default;
+    FixedPolygon(const double centerX, const double centerY, const std::array<double, N> &offsetX,
+                 const std::array<double, N> &offsetY)
+        : offsetX(offsetX), offsetY(offsetY), centerX(centerX), centerY(centerY), valid(true) {
+        const auto [minX, maxX] = std::minmax_element(this->offsetX.begin(), this->offsetX.end());
+        const auto [minY, maxY] = std::minmax_element(this->offsetY.begin(), this->offsetY.end());
+        this->minOffsetX = *minX;
+        this->maxOffsetX = *maxX;
+        this->minOffsetY = *minY;
+        this->maxOffsetY = *maxY;
+    }
+
+    // Polígono regular com o primeiro vértice no ângulo 0
+    static FixedPolygon regular(const double centerX, const double centerY, const double radius) {
+        std::array<double, N> offsetX;
+        std::array<double, N> offsetY;
+        for (int k = 0; k < N; k++) {
+            const double angle = 2.0 * M_PI / N * k;
+            offsetX[k] = radius * std::cos(angle);
+            offsetY[k] = radius * std::sin(angle);
+        }
+        return FixedPolygon(centerX, centerY, offsetX, offsetY);
+    }
+
+    bool isValid() const { return this->valid; }
+    int getNumVertices() const { return this->valid ? N : 0; }
+    double getVertexX(const int k) const { return this->centerX + this->offsetX[k]; }
+    double getVertexY(const int k) const { return this->centerY + this->offsetY[k]; }
+    double getCenterX() const { return this->centerX; }
+    double getCenterY() const { return this->centerY; }
+    double getMinX() const { return this->centerX + this->minOffsetX; }
+    double getMaxX() const { return this->centerX + this->maxOffsetX; }
+    double getMinY() const { return this->centerY + this->minOffsetY; }
+    double getMaxY() const { return this->centerY + this->maxOffsetY; }
+
+    double getVelocityX() const { return this->velocityX; }
+    double getVelocityY() const { return this->velocityY; }
+    bool getDraggable() const { return this->isDraggable; }
+    bool getDragging() const { return this->isBeingDragged; }
+
+    void setVelocityX(const double newVelocityX) { this->velocityX = newVelocityX; }
+    void setVelocityY(const double newVelocityY) { this->velocityY = newVelocityY; }
+    void setDraggable(const bool draggable) { this->isDraggable = draggable; }
+    void setDragging(const bool dragging) { this->isBeingDragged = dragging; }
+
+    void translate(const double dx, const double dy) {
+        this->centerX += dx;
+        this->centerY += dy;
+    }
+
+    void moveTo(const double newCenterX, const double newCenterY) {
+        if (!this->valid) return;
+
+        this->centerX = newCenterX;
+        this->centerY = newCenterY;
+    }
+
+    bool updatePosition(const double dx, const double dy, const UniformGrid &grid) {
+        const double newCenterX = this->centerX + dx;
+        const double newCenterY = this->centerY + dy;
+
+        // Se o centro for para uma célula inválida (não possui arestas) o movimento não é executado
+        const int cellI = static_cast<int>(std::floor(newCenterX / grid.getCellSize()));
+        const int cellJ = static_cast<int>(std::floor(newCenterY / grid.getCellSize()));
+        if (!grid.hasEdges(Cell(cellI, cellJ))) return false;
+
+        this->translate(dx, dy);
+        return true;
+    }
+
+    // Mesmo critério e mesmas operações de PolygonBatch: o ponto não pode estar à direita de nenhuma aresta
+    // (tolerância EPS, por isso sem rejeição pela caixa delimitadora)
+    bool containsPoint(const double x, const double y) const {
+        if (!this->valid) return false;
+
+        for (int k = 0; k < N; k++) {
+            const int next = k + 1 == N ? 0 : k + 1;
+            const double originX = this->getVertexX(k);
+            const double originY = this->getVertexY(k);
+            const double edgeX = this->getVertexX(next) - originX;
+            const double edgeY = this->getVertexY(next) - originY;
+            if (edgeX * (y - originY) - edgeY * (x - originX) < -EPS) return false;
+        }
+
+        return true;
+    }
+
+    // Polígono regular com o centro em uma célula não vazia da grade (inválido se a grade estiver vazia)
+    static FixedPolygon generateInGrid(const UniformGrid &grid, const double radius, Philox &rng) {
+        const std::vector<Cell> &nonEmptyCells = grid.getNonEmptyCells();
+        if (nonEmptyCells.empty()) return {};
+
+        const Cell chosenCell = nonEmptyCells[rng.uniformInt(0, static_cast<int>(nonEmptyCells.size() - 1))];
+
+        const double x0 = chosenCell.getI() * grid.getCellSize();
+        const double y0 = chosenCell.getJ() * grid.getCellSize();
+
+        const double centerX = rng.uniform(x0 + maxMoveDistance, x0 + grid.getCellSize() - maxMoveDistance);
+        const double centerY = rng.uniform(y0 + maxMoveDistance, y0 + grid.getCellSize() - maxMoveDistance);
+        return regular(centerX, centerY, radius);
+    }
+};
+
+// Zonas de congestionamento da simulação
+using Hexagon = FixedPolygon<6>;
+
+
+#endif //PROJETOCONCLUSAOCURSO_FIXED_POLYGON_H
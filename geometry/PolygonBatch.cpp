@@ -0,0 +1,147 @@
+#include "PolygonBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../helper/PointHelper.h"
+
+void PolygonBatch::assign(const std::vector<Hexagon> &polygons) {
+    this->numPolygons = static_cast<int>(polygons.size());
+    this->numEdges = 0;
+    for (const Hexagon &polygon : polygons) {
+        this->numEdges = std::max(this->numEdges, polygon.getNumVertices());
+    }
+
+    const std::size_t total = static_cast<std::size_t>(this->numEdges) * this->numPolygons;
+    this->originX.assign(total, 0.0);
+    this->originY.assign(total, 0.0);
+    this->edgeX.assign(total, 0.0);
+    this->edgeY.assign(total, 0.0);
+    this->valid.assign(this->numPolygons, 0);
+
+    for (int p = 0; p < this->numPolygons; p++) {
+        const Hexagon &polygon = polygons[p];
+        const int n = polygon.getNumVertices();
+        if (n < 3) continue;
+
+        this->valid[p] = 1;
+        for (int k = 0; k < n; k++) {
+            const int next = (k + 1) % n;
+            const std::size_t pos = static_cast<std::size_t>(k) * this->numPolygons + p;
+
+            this->originX[pos] = polygon.getVertexX(k);
+            this->originY[pos] = polygon.getVertexY(k);
+            this->edgeX[pos] = polygon.getVertexX(next) - polygon.getVertexX(k);
+            this->edgeY[pos] = polygon.getVertexY(next) - polygon.getVertexY(k);
+        }
+    }
+}
+
+void PolygonBatch::containsPoint(const double x, const double y, std::uint8_t *inside) const {
+    const int n = this->numPolygons;
+
+    // O ponto está dentro quando fica à esquerda (ou sobre) todas as arestas, ou seja, quando o menor
+    // produto vetorial não é negativo. Os polígonos são processados em blocos, aresta a aresta
+    double minCross[blockSize];
+
+    for (int begin = 0; begin < n; begin += blockSize) {
+        const int size = std::min(blockSize, n - begin);
+        std::fill(minCross, minCross + size, INFINITY);
+
+        for (int k = 0; k < this->numEdges; k++) {
+            const std::size_t offset = static_cast<std::size_t>(k) * n + begin;
+            const double *ox = this->originX.data() + offset;
+            const double *oy = this->originY.data() + offset;
+            const double *ex = this->edgeX.data() + offset;
+            const double *ey = this->edgeY.data() + offset;
+
+            #pragma omp simd
+            for (int p = 0; p < size; p++) {
+                minCross[p] = std::min(minCross[p], ex[p] * (y - oy[p]) - ey[p] * (x - ox[p]));
+            }
+        }
+
+        for (int p = 0; p < size; p++) {
+            inside[begin + p] = this->valid[begin + p] && minCross[p] >= -EPS;
+        }
+    }
+}
+
+void PolygonBatch::containsPoints(const int polygon, const double *xs, const double *ys, const int count,
+                                  std::uint8_t *inside) const {
+    if (!this->valid[polygon]) {
+        std::fill(inside, inside + count, 0);
+        return;
+    }
+
+    // Mesmo teste com as arestas do polígono fixas e os pontos processados em blocos
+    double minCross[blockSize];
+
+    for (int begin = 0; begin < count; begin += blockSize) {
+        const int size = std::min(blockSize, count - begin);
+        const double *px = xs + begin;
+        const double *py = ys + begin;
+        std::fill(minCross, minCross + size, INFINITY);
+
+        for (int k = 0; k < this->numEdges; k++) {
+            const std::size_t pos = static_cast<std::size_t>(k) * this->numPolygons + polygon;
+            const double ox = this->originX[pos];
+            const double oy = this->originY[pos];
+            const double ex = this->edgeX[pos];
+            const double ey = this->edgeY[pos];
+
+            #pragma omp simd
+            for (int i = 0; i < size; i++) {
+                minCross[i] = std::min(minCross[i], ex * (py[i] - oy) - ey * (px[i] - ox));
+            }
+        }
+
+        for (int i = 0; i < size; i++) {
+            inside[begin + i] = minCross[i] >= -EPS;
+        }
+    }
+}
+
+bool PolygonBatch::containsPointScalar(const int polygon, const double x, const double y) const {
+    if (!this->valid[polygon]) return false;
+
+    for (int k = 0; k < this->numEdges; k++) {
+        const std::size_t pos = static_cast<std::size_t>(k) * this->numPolygons + polygon;
+        if (this->edgeX[pos] * (y - this->originY[pos]) - this->edgeY[pos] * (x - this->originX[pos]) < -EPS) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool PolygonBatch::intersectsSegment(const int polygon, const double x1, const double y1, const double x2, const double y2) const {
+    if (!this->valid[polygon]) return false;
+
+    // Recorte de Cyrus-Beck: cada aresta limita o intervalo [tEnter, tExit] do segmento que fica do lado de dentro
+    const double dx = x2 - x1;
+    const double dy = y2 - y1;
+    double tEnter = 0.0;
+    double tExit = 1.0;
+
+    for (int k = 0; k < this->numEdges; k++) {
+        const std::size_t pos = static_cast<std::size_t>(k) * this->numPolygons + polygon;
+
+        // Produto vetorial em função de t: start + t * slope (>= -EPS do lado de dentro)
+        const double start = this->edgeX[pos] * (y1 - this->originY[pos]) - this->edgeY[pos] * (x1 - this->originX[pos]);
+        const double slope = this->edgeX[pos] * dy - this->edgeY[pos] * dx;
+
+        if (slope == 0.0) {
+            if (start < -EPS) return false;
+            continue;
+        }
+
+        const double t = (-EPS - start) / slope;
+        if (slope > 0.0) tEnter = std::max(tEnter, t);
+        else tExit = std::min(tExit, t);
+
+        if (tEnter > tExit) return false;
+    }
+
+    return true;
+}
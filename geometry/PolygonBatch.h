@@ -0,0 +1,41 @@
+#ifndef PROJETOCONCLUSAOCURSO_POLYGON_BATCH_H
+#define PROJETOCONCLUSAOCURSO_POLYGON_BATCH_H
+#include <cstdint>
+#include <vector>
+
+#include "FixedPolygon.h"
+
+
+// Polígonos convexos (sentido anti-horário) em estrutura de arrays para os testes ponto-polígono em lote
+// A aresta k do polígono p fica na posição k * numPolygons + p: um ponto é testado contra vários polígonos
+// percorrendo posições contíguas. Os polígonos com menos arestas são completados com arestas nulas (sempre aceitas)
+class PolygonBatch {
+    static constexpr int blockSize = 256;       // Polígonos/pontos processados juntos pelos kernels
+
+    int numPolygons = 0;
+    int numEdges = 0;                   // Arestas por polígono (as do maior polígono)
+    std::vector<double> originX;        // Vértice inicial de cada aresta
+    std::vector<double> originY;
+    std::vector<double> edgeX;          // Vetor da aresta (próximo vértice - vértice inicial)
+    std::vector<double> edgeY;
+    std::vector<std::uint8_t> valid;    // Polígonos com menos de três vértices nunca contêm pontos
+
+public:
+    void assign(const std::vector<Hexagon> &polygons);
+
+    int size() const { return this->numPolygons; }
+
+    // Um ponto contra todos os polígonos: inside[p] = 1 se o ponto está dentro do polígono p
+    void containsPoint(double x, double y, std::uint8_t *inside) const;
+    // Vários pontos (xs[i], ys[i]) contra o polígono: inside[i] = 1 se o ponto i está dentro
+    void containsPoints(int polygon, const double *xs, const double *ys, int count, std::uint8_t *inside) const;
+
+    // Versão escalar (um ponto, um polígono) com o mesmo resultado dos kernels
+    bool containsPointScalar(int polygon, double x, double y) const;
+
+    // Se o segmento (x1, y1) -> (x2, y2) tem algum ponto dentro do polígono (mesma tolerância dos testes de ponto)
+    bool intersectsSegment(int polygon, double x1, double y1, double x2, double y2) const;
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_POLYGON_BATCH_H
@@ -0,0 +1,176 @@
+#include "PolygonIndex.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+PolygonIndex::CellRange PolygonIndex::computeRange(const Hexagon &polygon, const double cellSize) {
+    CellRange range;
+    if (!polygon.isValid()) return range;
+
+    // Caixa delimitadora já mantida pelo polígono
+    range.iMin = static_cast<int>(std::floor(polygon.getMinX() / cellSize));
+    range.iMax = static_cast<int>(std::floor(polygon.getMaxX() / cellSize));
+    range.jMin = static_cast<int>(std::floor(polygon.getMinY() / cellSize));
+    range.jMax = static_cast<int>(std::floor(polygon.getMaxY() / cellSize));
+
+    return range;
+}
+
+std::uint64_t PolygonIndex::blockMask(const CellRange &range, const int bi, const int bj) {
+    // Intervalo recortado pelo bloco, em coordenadas locais
+    const int iLo = std::max(range.iMin, bi * blockCells) - bi * blockCells;
+    const int iHi = std::min(range.iMax, bi * blockCells + blockCells - 1) - bi * blockCells;
+    const int jLo = std::max(range.jMin, bj * blockCells) - bj * blockCells;
+    const int jHi = std::min(range.jMax, bj * blockCells + blockCells - 1) - bj * blockCells;
+    if (iLo > iHi || jLo > jHi) return 0;
+
+    const std::uint64_t row = ((std::uint64_t{1} << (jHi - jLo + 1)) - 1) << jLo;
+    std::uint64_t mask = 0;
+    for (int i = iLo; i <= iHi; i++) {
+        mask |= row << (i * blockCells);
+    }
+
+    return mask;
+}
+
+void PolygonIndex::insert(const int polygon) {
+    const CellRange &range = this->ranges[polygon];
+
+    // Insere o polígono nas listas por célula de um bloco dividido
+    const auto insertCells = [](Block &block, const int id, std::uint64_t mask) {
+        for (; mask != 0; mask &= mask - 1) {
+            block.cells[std::countr_zero(mask)].push_back(id);
+        }
+    };
+
+    for (int bi = floorDiv(range.iMin, blockCells); bi <= floorDiv(range.iMax, blockCells); bi++) {
+        for (int bj = floorDiv(range.jMin, blockCells); bj <= floorDiv(range.jMax, blockCells); bj++) {
+            const std::uint64_t mask = blockMask(range, bi, bj);
+            Block &block = this->blocks[Cell(bi, bj)];
+            block.polygons.push_back(polygon);
+            block.occupied |= mask;
+
+            if (!block.cells.empty()) {
+                insertCells(block, polygon, mask);
+            } else if (static_cast<int>(block.polygons.size()) > maxLeafPolygons) {
+                // Bloco ficou denso: passa a ter uma lista por célula
+                block.cells.resize(blockCells * blockCells);
+                for (const int id : block.polygons) {
+                    insertCells(block, id, blockMask(this->ranges[id], bi, bj));
+                }
+            }
+        }
+    }
+}
+
+void PolygonIndex::erase(const int polygon) {
+    const CellRange &range = this->ranges[polygon];
+
+    // Poucos polígonos por lista: troca com o último e remove
+    const auto removeFrom = [polygon](std::vector<int> &list) {
+        const auto pos = std::find(list.begin(), list.end(), polygon);
+        if (pos != list.end()) {
+            *pos = list.back();
+            list.pop_back();
+        }
+    };
+
+    for (int bi = floorDiv(range.iMin, blockCells); bi <= floorDiv(range.iMax, blockCells); bi++) {
+        for (int bj = floorDiv(range.jMin, blockCells); bj <= floorDiv(range.jMax, blockCells); bj++) {
+            const auto it = this->blocks.find(Cell(bi, bj));
+            if (it == this->blocks.end()) continue;
+
+            Block &block = it->second;
+            removeFrom(block.polygons);
+
+            // Bloco sem polígonos deixa de existir
+            if (block.polygons.empty()) {
+                this->blocks.erase(it);
+                continue;
+            }
+
+            if (!block.cells.empty() && static_cast<int>(block.polygons.size()) > maxLeafPolygons) {
+                // Continua denso: só as células do polígono mudam
+                for (std::uint64_t mask = blockMask(range, bi, bj); mask != 0; mask &= mask - 1) {
+                    const int local = std::countr_zero(mask);
+                    removeFrom(block.cells[local]);
+                    if (block.cells[local].empty()) block.occupied &= ~(std::uint64_t{1} << local);
+                }
+                continue;
+            }
+
+            // Bloco esparso (ou que voltou a ser): ocupação refeita pelos polígonos restantes
+            block.cells.clear();
+            block.occupied = 0;
+            for (const int id : block.polygons) {
+                block.occupied |= blockMask(this->ranges[id], bi, bj);
+            }
+        }
+    }
+}
+
+void PolygonIndex::reset(const double newCellSize) {
+    this->cellSize = newCellSize;
+    this->blocks.clear();
+    this->ranges.clear();
+}
+
+void PolygonIndex::add(const Hexagon &polygon) {
+    this->ranges.push_back(computeRange(polygon, this->cellSize));
+    this->insert(static_cast<int>(this->ranges.size()) - 1);
+}
+
+int PolygonIndex::update(const std::vector<Hexagon> &polygons) {
+    int moved = 0;
+
+    for (int p = 0; p < static_cast<int>(polygons.size()); p++) {
+        const CellRange range = computeRange(polygons[p], this->cellSize);
+        if (range == this->ranges[p]) continue;
+
+        this->erase(p);
+        this->ranges[p] = range;
+        this->insert(p);
+        moved++;
+    }
+
+    this->reinsertions += moved;
+    return moved;
+}
+
+const std::vector<int> *PolygonIndex::polygonsAt(const Cell &cell) const {
+    const auto it = this->blocks.find(getBlock(cell));
+    if (it == this->blocks.end()) return nullptr;
+
+    const Block &block = it->second;
+    const int local = getLocalIndex(cell);
+    if ((block.occupied >> local & 1) == 0) return nullptr;
+
+    return block.cells.empty() ? &block.polygons : &block.cells[local];
+}
+
+bool PolygonIndex::isCellOccupied(const Cell &cell) const {
+    const auto it = this->blocks.find(getBlock(cell));
+    if (it == this->blocks.end()) return false;
+
+    const int local = getLocalIndex(cell);
+    return (it->second.occupied >> local & 1) != 0;
+}
+
+int PolygonIndex::getNumOccupiedCells() const {
+    int total = 0;
+    for (const auto &[key, block] : this->blocks) {
+        total += std::popcount(block.occupied);
+    }
+
+    return total;
+}
+
+int PolygonIndex::getNumSplitBlocks() const {
+    int total = 0;
+    for (const auto &[key, block] : this->blocks) {
+        if (!block.cells.empty()) total++;
+    }
+
+    return total;
+}
@@ -0,0 +1,78 @@
+#ifndef PROJETOCONCLUSAOCURSO_POLYGON_INDEX_H
+#define PROJETOCONCLUSAOCURSO_POLYGON_INDEX_H
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Cell.h"
+#include "FixedPolygon.h"
+#include "UniformGrid.h"
+
+
+// Índice espacial dos polígonos: célula da grade -> polígonos cuja caixa delimitadora ocupa a célula
+// Usa os mesmos blocos de UniformGrid: um bloco com poucos polígonos guarda uma única lista e um bloco
+// denso guarda uma lista por célula. A ocupação é sempre exata no nível fino (um bit por célula).
+// É mantido de forma incremental, apenas os polígonos que cruzaram o limite de uma célula são reinseridos
+class PolygonIndex {
+public:
+    // Intervalo de células [iMin, iMax] x [jMin, jMax] ocupado pela caixa delimitadora de um polígono
+    struct CellRange {
+        int iMin = 0;
+        int iMax = -1;
+        int jMin = 0;
+        int jMax = -1;
+
+        bool operator==(const CellRange &other) const {
+            return iMin == other.iMin && iMax == other.iMax && jMin == other.jMin && jMax == other.jMax;
+        }
+    };
+
+    static constexpr int blockCells = UniformGrid::blockCells;
+    static constexpr int maxLeafPolygons = 4;           // Acima disso o bloco é dividido em listas por célula
+
+private:
+    struct Block {
+        std::uint64_t occupied = 0;                     // Células ocupadas do bloco (i * blockCells + j)
+        std::vector<int> polygons;                      // Polígonos que ocupam alguma célula do bloco
+        std::vector<std::vector<int>> cells;            // Lista por célula (vazio se o bloco não é dividido)
+    };
+
+    double cellSize = 0.01;
+    std::unordered_map<Cell, Block, Cell::Hash> blocks; // Coordenadas do bloco -> bloco (só os ocupados)
+    std::vector<CellRange> ranges;          // Células atuais de cada polígono
+    long long reinsertions = 0;             // Polígonos reinseridos desde a criação do índice
+
+    static int floorDiv(const int a, const int b) { return a >= 0 ? a / b : -((-a + b - 1) / b); }
+    static Cell getBlock(const Cell &cell) { return {floorDiv(cell.getI(), blockCells), floorDiv(cell.getJ(), blockCells)}; }
+    // Posição da célula dentro do bloco (i * blockCells + j)
+    static int getLocalIndex(const Cell &cell) {
+        return (cell.getI() - floorDiv(cell.getI(), blockCells) * blockCells) * blockCells +
+               (cell.getJ() - floorDiv(cell.getJ(), blockCells) * blockCells);
+    }
+    // Células do intervalo dentro do bloco (bi, bj), um bit por célula
+    static std::uint64_t blockMask(const CellRange &range, int bi, int bj);
+
+    void insert(int polygon);
+    void erase(int polygon);
+
+public:
+    static CellRange computeRange(const Hexagon &polygon, double cellSize);
+
+    void reset(double newCellSize);
+    void add(const Hexagon &polygon);
+    // Atualiza as células dos polígonos que mudaram, retorna quantos foram reinseridos
+    int update(const std::vector<Hexagon> &polygons);
+
+    // Polígonos que podem ocupar a célula (os de todo o bloco quando ele não é dividido), nullptr se nenhum
+    const std::vector<int> *polygonsAt(const Cell &cell) const;
+    bool isCellOccupied(const Cell &cell) const;
+
+    const CellRange &getRange(const int polygon) const { return this->ranges[polygon]; }
+    int getNumOccupiedCells() const;
+    int getNumBlocks() const { return static_cast<int>(this->blocks.size()); }
+    int getNumSplitBlocks() const;
+    long long getReinsertions() const { return this->reinsertions; }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_POLYGON_INDEX_H
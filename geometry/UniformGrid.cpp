@@ -0,0 +1,222 @@
+#include "UniformGrid.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+void UniformGrid::insertEdge(const int edge, const Point &u, const Point &v) {
+    int i = static_cast<int>(std::floor(u.getX() / this->cellSize));
+    int j = static_cast<int>(std::floor(u.getY() / this->cellSize));
+    const int iEnd = static_cast<int>(std::floor(v.getX() / this->cellSize));
+    const int jEnd = static_cast<int>(std::floor(v.getY() / this->cellSize));
+
+    const double dx = v.getX() - u.getX();
+    const double dy = v.getY() - u.getY();
+    const int stepI = iEnd > i ? 1 : -1;
+    const int stepJ = jEnd > j ? 1 : -1;
+
+    // Parâmetro t (0 em u, 1 em v) em que o segmento cruza a próxima borda vertical/horizontal
+    // e quanto t avança a cada célula atravessada
+    double tMaxX = INFINITY;
+    double tMaxY = INFINITY;
+    double tDeltaX = INFINITY;
+    double tDeltaY = INFINITY;
+    if (i != iEnd) {
+        tMaxX = ((i + (stepI > 0 ? 1 : 0)) * this->cellSize - u.getX()) / dx;
+        tDeltaX = this->cellSize / std::abs(dx);
+    }
+    if (j != jEnd) {
+        tMaxY = ((j + (stepJ > 0 ? 1 : 0)) * this->cellSize - u.getY()) / dy;
+        tDeltaY = this->cellSize / std::abs(dy);
+    }
+
+    // A quantidade de passos é fixa (distância de Manhattan entre as células), então erros de
+    // arredondamento nunca fazem o percurso passar da célula final
+    const int steps = std::abs(iEnd - i) + std::abs(jEnd - j);
+    this->pending[Cell(i, j)].push_back(edge);
+
+    for (int s = 0; s < steps; s++) {
+        if (i != iEnd && (j == jEnd || tMaxX < tMaxY)) {
+            i += stepI;
+            tMaxX += tDeltaX;
+        } else {
+            j += stepJ;
+            tMaxY += tDeltaY;
+        }
+
+        this->pending[Cell(i, j)].push_back(edge);
+    }
+}
+
+void UniformGrid::insertEdgeBoundingBox(const int edge, const Point &u, const Point &v) {
+    // Calcula a caixa delimitadora
+    const int iMin = floor(std::min(u.getX(), v.getX()) / this->cellSize);
+    const int iMax = floor(std::max(u.getX(), v.getX()) / this->cellSize);
+    const int jMin = floor(std::min(u.getY(), v.getY()) / this->cellSize);
+    const int jMax = floor(std::max(u.getY(), v.getY()) / this->cellSize);
+
+    // Adicionar a aresta em todas as células dessa caixa
+    for (int i = iMin; i <= iMax; i++) {
+        for (int j = jMin; j <= jMax; j++) {
+            this->pending[Cell(i,j)].push_back(edge);
+        }
+    }
+}
+
+void UniformGrid::finalize() {
+    int biMax = INT_MIN;
+    int bjMax = INT_MIN;
+    this->biMin = INT_MAX;
+    this->bjMin = INT_MAX;
+
+    for (const auto &[cell, edges] : this->pending) {
+        const int bi = floorDiv(cell.getI(), blockCells);
+        const int bj = floorDiv(cell.getJ(), blockCells);
+        this->biMin = std::min(this->biMin, bi);
+        this->bjMin = std::min(this->bjMin, bj);
+        biMax = std::max(biMax, bi);
+        bjMax = std::max(bjMax, bj);
+    }
+
+    if (this->pending.empty()) {
+        this->biMin = this->bjMin = 0;
+        biMax = bjMax = -1;
+    }
+
+    this->numBI = biMax - this->biMin + 1;
+    this->numBJ = bjMax - this->bjMin + 1;
+    const int numBlocks = this->numBI * this->numBJ;
+
+    // Células de cada bloco (posição local i * blockCells + j -> arestas)
+    std::vector<std::vector<std::pair<int, const std::vector<int> *>>> blockCellsEdges(numBlocks);
+    for (const auto &[cell, edges] : this->pending) {
+        if (edges.empty()) continue;
+
+        const int block = this->getBlockIndex(cell);
+        const int local = getLocalIndex(cell);
+        blockCellsEdges[block].emplace_back(local, &edges);
+    }
+
+    this->blockFirstList.assign(numBlocks, -1);
+    this->blockSplit.assign(numBlocks, 0);
+    this->blockOccupied.assign(numBlocks, 0);
+    this->listFirst.assign(1, 0);
+    this->listEdges.clear();
+    this->nonEmptyCells.clear();
+
+    std::vector<int> distinct;
+    const std::vector<int> *cellEdges[blockCells * blockCells];
+
+    for (int block = 0; block < numBlocks; block++) {
+        auto &cells = blockCellsEdges[block];
+        if (cells.empty()) continue;
+
+        std::fill(std::begin(cellEdges), std::end(cellEdges), nullptr);
+        distinct.clear();
+        for (const auto &[local, edges] : cells) {
+            cellEdges[local] = edges;
+            this->blockOccupied[block] |= 1ULL << local;
+            distinct.insert(distinct.end(), edges->begin(), edges->end());
+        }
+
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+        this->blockFirstList[block] = this->getNumLists();
+
+        if (static_cast<int>(distinct.size()) <= maxLeafEdges) {
+            // Região esparsa: uma lista para o bloco inteiro
+            this->listEdges.insert(this->listEdges.end(), distinct.begin(), distinct.end());
+            this->listFirst.push_back(static_cast<int>(this->listEdges.size()));
+        } else {
+            // Região densa: uma lista por célula (vazia se a célula não possui arestas)
+            this->blockSplit[block] = 1;
+            for (int local = 0; local < blockCells * blockCells; local++) {
+                if (cellEdges[local] != nullptr) {
+                    this->listEdges.insert(this->listEdges.end(), cellEdges[local]->begin(), cellEdges[local]->end());
+                }
+                this->listFirst.push_back(static_cast<int>(this->listEdges.size()));
+            }
+        }
+
+        // Em ordem de bloco e de célula (não depende da ordem da tabela hash)
+        const int bi = this->biMin + block / this->numBJ;
+        const int bj = this->bjMin + block % this->numBJ;
+        for (int local = 0; local < blockCells * blockCells; local++) {
+            if ((this->blockOccupied[block] >> local) & 1ULL) {
+                this->nonEmptyCells.emplace_back(bi * blockCells + local / blockCells, bj * blockCells + local % blockCells);
+            }
+        }
+    }
+
+    std::unordered_map<Cell, std::vector<int>, Cell::Hash>().swap(this->pending);
+    this->finalized = true;
+}
+
+int UniformGrid::getBlockIndex(const Cell &cell) const {
+    const int bi = floorDiv(cell.getI(), blockCells) - this->biMin;
+    const int bj = floorDiv(cell.getJ(), blockCells) - this->bjMin;
+    if (bi < 0 || bi >= this->numBI || bj < 0 || bj >= this->numBJ) return -1;
+    return bi * this->numBJ + bj;
+}
+
+int UniformGrid::getCellIndex(const Cell &cell) const {
+    const int block = this->getBlockIndex(cell);
+    return block < 0 ? -1 : block * blockCells * blockCells + getLocalIndex(cell);
+}
+
+int UniformGrid::getCellList(const Cell &cell) const {
+    const int block = this->getBlockIndex(cell);
+    if (block < 0 || this->blockFirstList[block] < 0) return -1;
+    if (!this->blockSplit[block]) return this->blockFirstList[block];
+
+    const int local = getLocalIndex(cell);
+    if (!((this->blockOccupied[block] >> local) & 1ULL)) return -1;
+
+    return this->blockFirstList[block] + local;
+}
+
+void UniformGrid::collectLists(const int iMin, const int iMax, const int jMin, const int jMax, std::vector<int> &lists) const {
+    lists.clear();
+
+    for (int bi = floorDiv(iMin, blockCells); bi <= floorDiv(iMax, blockCells); bi++) {
+        for (int bj = floorDiv(jMin, blockCells); bj <= floorDiv(jMax, blockCells); bj++) {
+            const int block = this->getBlockIndex(Cell(bi * blockCells, bj * blockCells));
+            if (block < 0 || this->blockFirstList[block] < 0) continue;
+
+            // Bloco não dividido: a mesma lista cobre todas as células dele
+            if (!this->blockSplit[block]) {
+                lists.push_back(this->blockFirstList[block]);
+                continue;
+            }
+
+            // Bloco dividido: apenas as células ocupadas dentro do intervalo
+            for (int i = std::max(iMin, bi * blockCells); i <= std::min(iMax, bi * blockCells + blockCells - 1); i++) {
+                for (int j = std::max(jMin, bj * blockCells); j <= std::min(jMax, bj * blockCells + blockCells - 1); j++) {
+                    const int local = (i - bi * blockCells) * blockCells + (j - bj * blockCells);
+                    if ((this->blockOccupied[block] >> local) & 1ULL) {
+                        lists.push_back(this->blockFirstList[block] + local);
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool UniformGrid::hasEdges(const Cell &cell) const {
+    const int block = this->getBlockIndex(cell);
+    if (block < 0) return false;
+
+    const int local = getLocalIndex(cell);
+    return (this->blockOccupied[block] >> local) & 1ULL;
+}
+
+int UniformGrid::getNumSplitBlocks() const {
+    return static_cast<int>(std::count(this->blockSplit.begin(), this->blockSplit.end(), 1));
+}
+
+std::size_t UniformGrid::memoryUsage() const {
+    return this->blockFirstList.capacity() * sizeof(int) + this->blockSplit.capacity() +
+           this->blockOccupied.capacity() * sizeof(std::uint64_t) + this->listFirst.capacity() * sizeof(int) +
+           this->listEdges.capacity() * sizeof(int) + this->nonEmptyCells.capacity() * sizeof(Cell);
+}
@@ -4,38 +4,89 @@
 
 #ifndef PROJETOCONCLUSAOCURSO_UNIFORM_GRID_H
 #define PROJETOCONCLUSAOCURSO_UNIFORM_GRID_H
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include "Cell.h"
-#include "Edge.h"
+#include "Point.h"
 
 
+// Grade das arestas em dois níveis
+// As células (nível fino) têm o tamanho escolhido a partir dos dados e são agrupadas em blocos de
+// blockCells x blockCells. Um bloco com poucas arestas guarda uma única lista (regiões esparsas) e um bloco
+// denso guarda uma lista por célula. A ocupação (célula possui arestas) é sempre exata no nível fino.
+// Durante a leitura as arestas ficam em uma tabela hash; finalize() monta os blocos (limites conhecidos)
 class UniformGrid {
-    std::unordered_map<Cell, std::vector<Edge *>, Cell::Hash> grid;
+public:
+    static constexpr int blockCells = 8;                    // Células por lado de um bloco (64 bits de ocupação)
+    static constexpr int maxLeafEdges = 32;                 // Acima disso o bloco é dividido em listas por célula
+
+private:
+    std::unordered_map<Cell, std::vector<int>, Cell::Hash> pending;   // Célula -> índices das arestas (antes de finalize)
     double cellSize;
 
+    int biMin = 0;                      // Primeiro bloco da matriz densa de blocos
+    int bjMin = 0;
+    int numBI = 0;                      // Dimensões da matriz de blocos
+    int numBJ = 0;
+    std::vector<int> blockFirstList;    // Primeira lista de cada bloco (-1 se o bloco não possui arestas)
+    std::vector<std::uint8_t> blockSplit;           // Se o bloco possui uma lista por célula
+    std::vector<std::uint64_t> blockOccupied;       // Ocupação das células de cada bloco (um bit por célula)
+
+    std::vector<int> listFirst;         // Início das arestas de cada lista (CSR)
+    std::vector<int> listEdges;         // Arestas de todas as listas, contíguas
+    std::vector<Cell> nonEmptyCells;
+    bool finalized = false;
+
+    static int floorDiv(const int a, const int b) { return a >= 0 ? a / b : -((-a + b - 1) / b); }
+    // Posição da célula dentro do bloco (i * blockCells + j)
+    static int getLocalIndex(const Cell &cell) {
+        return (cell.getI() - floorDiv(cell.getI(), blockCells) * blockCells) * blockCells +
+               (cell.getJ() - floorDiv(cell.getJ(), blockCells) * blockCells);
+    }
+    int getBlockIndex(const Cell &cell) const;
+
 public:
     UniformGrid() : cellSize(0.01) {}
     explicit UniformGrid(const double cellSize) : cellSize(cellSize) {}
 
-    const std::unordered_map<Cell, std::vector<Edge *>, Cell::Hash> &getGrid() const { return this->grid; }
     double getCellSize() const { return this->cellSize; }
+    bool isFinalized() const { return this->finalized; }
 
-    void insertEdge(Edge *edge) {
-        // Calcula a caixa delimitadora
-        const int iMin = floor(std::min(edge->getU()->getX(), edge->getV()->getX()) / this->cellSize);
-        const int iMax = floor(std::max(edge->getU()->getX(), edge->getV()->getX()) / this->cellSize);
-        const int jMin = floor(std::min(edge->getU()->getY(), edge->getV()->getY()) / this->cellSize);
-        const int jMax = floor(std::max(edge->getU()->getY(), edge->getV()->getY()) / this->cellSize);
-
-        // Adicionar a aresta em todas as células dessa caixa
-        for (int i = iMin; i <= iMax; i++) {
-            for (int j = jMin; j <= jMax; j++) {
-                this->grid[Cell(i,j)].push_back(edge);
-            }
-        }
-    }
+    // Insere a aresta apenas nas células atravessadas pelo segmento u -> v (percurso de Amanatides-Woo)
+    void insertEdge(int edge, const Point &u, const Point &v);
+    // Insere a aresta em todas as células da caixa delimitadora (layout anterior, usado na comparação do benchmark)
+    void insertEdgeBoundingBox(int edge, const Point &u, const Point &v);
+
+    // Monta os blocos em uma passada pelas células e libera a tabela hash
+    void finalize();
+
+    // Índice denso da célula na matriz de blocos (bloco * células por bloco + posição no bloco), -1 fora dela
+    int getCellIndex(const Cell &cell) const;
+    // Lista com as arestas da célula (as de todo o bloco quando ele não é dividido), -1 se não houver
+    int getCellList(const Cell &cell) const;
+    // Listas distintas que cobrem as células [iMin, iMax] x [jMin, jMax] (cada lista aparece uma vez)
+    void collectLists(int iMin, int iMax, int jMin, int jMax, std::vector<int> &lists) const;
+
+    // Se a célula possui arestas
+    bool hasEdges(const Cell &cell) const;
+
+    // Intervalo [beginList, endList) das arestas de uma lista
+    int beginList(const int list) const { return this->listFirst[list]; }
+    int endList(const int list) const { return this->listFirst[list + 1]; }
+    int getListEdge(const int pos) const { return this->listEdges[pos]; }
+
+    const std::vector<Cell> &getNonEmptyCells() const { return this->nonEmptyCells; }
+    int getNumCells() const { return this->numBI * this->numBJ * blockCells * blockCells; }
+    int getNumBlocks() const { return this->numBI * this->numBJ; }
+    int getNumSplitBlocks() const;
+    int getNumLists() const { return static_cast<int>(this->listFirst.size()) - 1; }
+    int getNumEntries() const { return static_cast<int>(this->listEdges.size()); }
+
+    // Memória ocupada pelos blocos e listas (em bytes)
+    std::size_t memoryUsage() const;
 };
 
 
-#endif //PROJETOCONCLUSAOCURSO_UNIFORM_GRID_H
\ No newline at end of file
+#endif //PROJETOCONCLUSAOCURSO_UNIFORM_GRID_H
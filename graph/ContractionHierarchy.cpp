@@ -0,0 +1,515 @@
+#include "ContractionHierarchy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+void ContractionHierarchy::build(const RoadNetwork &network) {
+    this->computeOrder(network);
+    this->contract(network);
+    this->buildTriangles();
+    this->ready = true;
+}
+
+void ContractionHierarchy::computeOrder(const RoadNetwork &network) {
+    const int numNodes = network.getNumNodes();
+
+    this->rank.assign(numNodes, -1);
+    this->order.assign(numNodes, -1);
+
+    std::vector<int> nodes(numNodes);
+    for (int i = 0; i < numNodes; i++) nodes[i] = i;
+
+    std::vector<int> token(numNodes, 0);
+    int nextToken = 1;
+    this->dissect(network, nodes, numNodes, token, nextToken);
+}
+
+void ContractionHierarchy::dissect(const RoadNetwork &network, std::vector<int> &nodes, const int rankEnd,
+                                   std::vector<int> &token, int &nextToken) {
+    const int size = static_cast<int>(nodes.size());
+    int nextRank = rankEnd - size;
+
+    // Conjuntos pequenos recebem os ranks diretamente
+    if (size <= 16) {
+        for (const int node : nodes) {
+            this->rank[node] = nextRank;
+            this->order[nextRank] = node;
+            nextRank++;
+        }
+        return;
+    }
+
+    // Divide pela mediana do eixo mais largo da caixa delimitadora (longitude corrigida pela latitude)
+    double minX = INFINITY, maxX = -INFINITY, minY = INFINITY, maxY = -INFINITY;
+    for (const int node : nodes) {
+        minX = std::min(minX, network.getX(node));
+        maxX = std::max(maxX, network.getX(node));
+        minY = std::min(minY, network.getY(node));
+        maxY = std::max(maxY, network.getY(node));
+    }
+
+    const double lonScale = std::cos((minY + maxY) / 2.0 * M_PI / 180.0);
+    const bool splitByX = (maxX - minX) * lonScale >= maxY - minY;
+
+    const auto middle = nodes.begin() + size / 2;
+    std::nth_element(nodes.begin(), middle, nodes.end(), [&](const int a, const int b) {
+        return splitByX ? network.getX(a) < network.getX(b) : network.getY(a) < network.getY(b);
+    });
+
+    std::vector<int> sideA(nodes.begin(), middle);
+    std::vector<int> sideB(middle, nodes.end());
+
+    const int tokenA = nextToken++;
+    const int tokenB = nextToken++;
+    for (const int node : sideA) token[node] = tokenA;
+    for (const int node : sideB) token[node] = tokenB;
+
+    // Separador de um lado: vértices que possuem algum vizinho (em qualquer sentido) do outro lado
+    const auto touches = [&](const int node, const int otherToken) {
+        for (int e = network.beginEdge(node); e < network.endEdge(node); e++) {
+            if (token[network.getEdgeTarget(e)] == otherToken) return true;
+        }
+        for (int i = network.beginInEdge(node); i < network.endInEdge(node); i++) {
+            if (token[network.getEdgeSource(network.getInEdge(i))] == otherToken) return true;
+        }
+        return false;
+    };
+
+    std::vector<int> separatorA, separatorB;
+    for (const int node : sideA) if (touches(node, tokenB)) separatorA.push_back(node);
+    for (const int node : sideB) if (touches(node, tokenA)) separatorB.push_back(node);
+
+    // Usa o menor separador e remove ele do seu lado
+    const bool useA = separatorA.size() <= separatorB.size();
+    std::vector<int> &separator = useA ? separatorA : separatorB;
+    std::vector<int> &separatedSide = useA ? sideA : sideB;
+
+    const int separatorToken = nextToken++;
+    for (const int node : separator) token[node] = separatorToken;
+    std::erase_if(separatedSide, [&](const int node) { return token[node] == separatorToken; });
+
+    // O separador fica com os maiores ranks do intervalo
+    int separatorRank = rankEnd - static_cast<int>(separator.size());
+    for (const int node : separator) {
+        this->rank[node] = separatorRank;
+        this->order[separatorRank] = node;
+        separatorRank++;
+    }
+
+    const int rankEndB = rankEnd - static_cast<int>(separator.size());
+    const int rankEndA = rankEndB - static_cast<int>(sideB.size());
+
+    nodes.clear();
+    nodes.shrink_to_fit();
+
+    this->dissect(network, sideB, rankEndB, token, nextToken);
+    this->dissect(network, sideA, rankEndA, token, nextToken);
+}
+
+void ContractionHierarchy::contract(const RoadNetwork &network) {
+    const int numNodes = network.getNumNodes();
+
+    // Vizinhos de maior rank de cada rank (grafo não direcionado)
+    std::vector<std::vector<int>> upper(numNodes);
+    for (int e = 0; e < network.getNumEdges(); e++) {
+        const int a = this->rank[network.getEdgeSource(e)];
+        const int b = this->rank[network.getEdgeTarget(e)];
+        if (a == b) continue;
+        upper[std::min(a, b)].push_back(std::max(a, b));
+    }
+
+    // Eliminação simbólica: ao eliminar r, seus vizinhos superiores formam uma clique
+    // Basta repassar esses vizinhos para o menor deles (pai na árvore de eliminação)
+    this->parent.assign(numNodes, -1);
+    for (int r = 0; r < numNodes; r++) {
+        std::vector<int> &neighbors = upper[r];
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+        if (neighbors.empty()) continue;
+
+        const int p = neighbors.front();
+        this->parent[r] = p;
+        upper[p].insert(upper[p].end(), neighbors.begin() + 1, neighbors.end());
+    }
+
+    // Monta o CSR dos arcos para cima
+    this->upFirst.assign(numNodes + 1, 0);
+    for (int r = 0; r < numNodes; r++) {
+        this->upFirst[r + 1] = this->upFirst[r] + static_cast<int>(upper[r].size());
+    }
+
+    this->upHead.resize(this->upFirst[numNodes]);
+    this->upTail.resize(this->upFirst[numNodes]);
+    for (int r = 0; r < numNodes; r++) {
+        std::copy(upper[r].begin(), upper[r].end(), this->upHead.begin() + this->upFirst[r]);
+        std::fill(this->upTail.begin() + this->upFirst[r], this->upTail.begin() + this->upFirst[r + 1], r);
+    }
+
+    // Arestas originais de cada arco
+    this->edgeArc.assign(network.getNumEdges(), -1);
+    std::vector<int> count(this->upHead.size() + 1, 0);
+    for (int e = 0; e < network.getNumEdges(); e++) {
+        const int a = this->rank[network.getEdgeSource(e)];
+        const int b = this->rank[network.getEdgeTarget(e)];
+        if (a == b) continue;
+
+        this->edgeArc[e] = this->findArc(std::min(a, b), std::max(a, b));
+        count[this->edgeArc[e] + 1]++;
+    }
+
+    for (std::size_t a = 0; a < this->upHead.size(); a++) count[a + 1] += count[a];
+    this->arcEdgeFirst = count;
+    this->arcEdges.resize(count.back());
+    for (int e = 0; e < network.getNumEdges(); e++) {
+        if (this->edgeArc[e] != -1) this->arcEdges[count[this->edgeArc[e]]++] = e;
+    }
+}
+
+void ContractionHierarchy::buildTriangles() {
+    const int numArcs = static_cast<int>(this->upHead.size());
+    const int numNodes = static_cast<int>(this->upFirst.size()) - 1;
+
+    // Todo par de arcos (v, u), (v, w) com u < w forma um triângulo inferior do arco (u, w)
+    std::vector<int> count(numArcs + 1, 0);
+    for (int v = 0; v < numNodes; v++) {
+        for (int i = this->upFirst[v]; i < this->upFirst[v + 1]; i++) {
+            for (int j = i + 1; j < this->upFirst[v + 1]; j++) {
+                count[this->findArc(this->upHead[i], this->upHead[j]) + 1]++;
+            }
+        }
+    }
+
+    for (int a = 0; a < numArcs; a++) count[a + 1] += count[a];
+    this->triangleFirst = count;
+    this->triangles.resize(count.back());
+
+    for (int v = 0; v < numNodes; v++) {
+        for (int i = this->upFirst[v]; i < this->upFirst[v + 1]; i++) {
+            for (int j = i + 1; j < this->upFirst[v + 1]; j++) {
+                const int arc = this->findArc(this->upHead[i], this->upHead[j]);
+                this->triangles[count[arc]++] = {i, j};
+            }
+        }
+    }
+
+    // Índice inverso: de cada lado inferior para os triângulos (e arcos superiores) que dependem dele
+    this->dependentFirst.assign(numArcs + 1, 0);
+    for (const Triangle &triangle : this->triangles) {
+        this->dependentFirst[triangle.lowerArcU + 1]++;
+        this->dependentFirst[triangle.lowerArcW + 1]++;
+    }
+
+    for (int a = 0; a < numArcs; a++) this->dependentFirst[a + 1] += this->dependentFirst[a];
+    this->dependents.resize(this->dependentFirst.back());
+
+    std::vector<int> next(this->dependentFirst.begin(), this->dependentFirst.end() - 1);
+    for (int arc = 0; arc < numArcs; arc++) {
+        for (int t = this->triangleFirst[arc]; t < this->triangleFirst[arc + 1]; t++) {
+            this->dependents[next[this->triangles[t].lowerArcU]++] = {arc, t};
+            this->dependents[next[this->triangles[t].lowerArcW]++] = {arc, t};
+        }
+    }
+}
+
+int ContractionHierarchy::findArc(const int lower, const int upper) const {
+    const auto begin = this->upHead.begin() + this->upFirst[lower];
+    const auto end = this->upHead.begin() + this->upFirst[lower + 1];
+    const auto it = std::lower_bound(begin, end, upper);
+
+    return it != end && *it == upper ? static_cast<int>(it - this->upHead.begin()) : -1;
+}
+
+bool ContractionHierarchy::recompute(Metric &metric, const int arc, const RoadNetwork &network,
+                                     const ObstacleSnapshot *obstacles) const {
+    double up = INFINITY, down = INFINITY;
+    int upMid = -1, downMid = -1;
+
+    // Peso das arestas originais (bloqueadas não contam)
+    for (int i = this->arcEdgeFirst[arc]; i < this->arcEdgeFirst[arc + 1]; i++) {
+        const int e = this->arcEdges[i];
+        if (obstacles && obstacles->isEdgeBlocked(e)) continue;
+
+        if (this->rank[network.getEdgeSource(e)] == this->upTail[arc]) {
+            up = std::min(up, network.getEdgeWeight(e));
+        } else {
+            down = std::min(down, network.getEdgeWeight(e));
+        }
+    }
+
+    // Caminhos u -> v -> w e w -> v -> u pelos triângulos inferiores
+    for (int t = this->triangleFirst[arc]; t < this->triangleFirst[arc + 1]; t++) {
+        const Triangle &triangle = this->triangles[t];
+
+        if (const double cost = metric.down[triangle.lowerArcU] + metric.up[triangle.lowerArcW]; cost < up) {
+            up = cost;
+            upMid = t;
+        }
+
+        if (const double cost = metric.down[triangle.lowerArcW] + metric.up[triangle.lowerArcU]; cost < down) {
+            down = cost;
+            downMid = t;
+        }
+    }
+
+    const bool changed = up != metric.up[arc] || down != metric.down[arc];
+
+    metric.up[arc] = up;
+    metric.down[arc] = down;
+    metric.upMid[arc] = upMid;
+    metric.downMid[arc] = downMid;
+
+    return changed;
+}
+
+void ContractionHierarchy::customize(Metric &metric, const RoadNetwork &network, const ObstacleSnapshot *obstacles) const {
+    const int numArcs = static_cast<int>(this->upHead.size());
+
+    metric.up.assign(numArcs, INFINITY);
+    metric.down.assign(numArcs, INFINITY);
+    metric.upMid.assign(numArcs, -1);
+    metric.downMid.assign(numArcs, -1);
+
+    // Os arcos estão ordenados pelo rank inferior, então os triângulos de cada arco já estão prontos
+    for (int a = 0; a < numArcs; a++) {
+        this->recompute(metric, a, network, obstacles);
+    }
+}
+
+int ContractionHierarchy::recustomize(Metric &metric, const RoadNetwork &network, const ObstacleSnapshot &obstacles,
+                                      const std::vector<int> &changedEdges) const {
+    // Processa os arcos afetados em ordem crescente (mesma ordem da customização completa)
+    std::priority_queue<int, std::vector<int>, std::greater<>> dirty;
+    std::vector<char> queued(this->upHead.size(), 0);
+
+    const auto markDirty = [&](const int arc) {
+        if (arc < 0) return;
+        if (!queued[arc]) {
+            queued[arc] = 1;
+            dirty.push(arc);
+        }
+    };
+
+    for (const int e : changedEdges) {
+        markDirty(this->edgeArc[e]);
+    }
+
+    int recomputed = 0;
+    while (!dirty.empty()) {
+        const int arc = dirty.top();
+        dirty.pop();
+        recomputed++;
+
+        if (!this->recompute(metric, arc, network, &obstacles)) continue;
+
+        // Um arco superior só precisa ser recalculado se esse triângulo era o mínimo dele ou passou a ser menor
+        for (int i = this->dependentFirst[arc]; i < this->dependentFirst[arc + 1]; i++) {
+            const auto [dependent, t] = this->dependents[i];
+            if (queued[dependent]) continue;
+
+            const Triangle &triangle = this->triangles[t];
+            const double upCost = metric.down[triangle.lowerArcU] + metric.up[triangle.lowerArcW];
+            const double downCost = metric.down[triangle.lowerArcW] + metric.up[triangle.lowerArcU];
+
+            if (metric.upMid[dependent] == t || metric.downMid[dependent] == t ||
+                upCost < metric.up[dependent] || downCost < metric.down[dependent]) {
+                markDirty(dependent);
+            }
+        }
+    }
+
+    return recomputed;
+}
+
+void ContractionHierarchy::unpack(const Metric &metric, const int arc, const bool upward, std::vector<int> &path) const {
+    const int t = upward ? metric.upMid[arc] : metric.downMid[arc];
+
+    // Aresta original: basta adicionar o destino do sentido percorrido
+    if (t == -1) {
+        path.push_back(this->order[upward ? this->upHead[arc] : this->upTail[arc]]);
+        return;
+    }
+
+    const Triangle &triangle = this->triangles[t];
+    if (upward) {
+        // u -> v -> w
+        this->unpack(metric, triangle.lowerArcU, false, path);
+        this->unpack(metric, triangle.lowerArcW, true, path);
+    } else {
+        // w -> v -> u
+        this->unpack(metric, triangle.lowerArcW, false, path);
+        this->unpack(metric, triangle.lowerArcU, true, path);
+    }
+}
+
+std::vector<int> ContractionHierarchy::query(const Metric &metric, const int idU, const int idV) const {
+    std::vector<int> path;
+    if (idU == idV) return path;
+
+    const int numNodes = static_cast<int>(this->order.size());
+
+    // Buffers da thread: permanecem em infinito entre as consultas (são limpos percorrendo os ancestrais)
+    thread_local std::vector<double> forwardCost, backwardCost;
+    thread_local std::vector<int> forwardArc, backwardArc;
+    if (static_cast<int>(forwardCost.size()) < numNodes) {
+        forwardCost.assign(numNodes, INFINITY);
+        backwardCost.assign(numNodes, INFINITY);
+        forwardArc.assign(numNodes, -1);
+        backwardArc.assign(numNodes, -1);
+    }
+
+    const int source = this->rank[idU];
+    const int target = this->rank[idV];
+
+    // Os espaços de busca para cima são exatamente os ancestrais na árvore de eliminação
+    forwardCost[source] = 0.0;
+    for (int x = source; x != -1; x = this->parent[x]) {
+        if (forwardCost[x] == INFINITY) continue;
+
+        for (int a = this->upFirst[x]; a < this->upFirst[x + 1]; a++) {
+            const int y = this->upHead[a];
+            if (const double cost = forwardCost[x] + metric.up[a]; cost < forwardCost[y]) {
+                forwardCost[y] = cost;
+                forwardArc[y] = a;
+            }
+        }
+    }
+
+    backwardCost[target] = 0.0;
+    for (int x = target; x != -1; x = this->parent[x]) {
+        if (backwardCost[x] == INFINITY) continue;
+
+        for (int a = this->upFirst[x]; a < this->upFirst[x + 1]; a++) {
+            const int y = this->upHead[a];
+            if (const double cost = backwardCost[x] + metric.down[a]; cost < backwardCost[y]) {
+                backwardCost[y] = cost;
+                backwardArc[y] = a;
+            }
+        }
+    }
+
+    // O encontro é o ancestral comum com menor soma
+    double best = INFINITY;
+    int meeting = -1;
+    for (int x = source; x != -1; x = this->parent[x]) {
+        if (const double cost = forwardCost[x] + backwardCost[x]; cost < best) {
+            best = cost;
+            meeting = x;
+        }
+    }
+
+    if (meeting != -1) {
+        // Origem -> encontro (arcos para cima, na ordem inversa da descoberta)
+        std::vector<int> forwardArcs;
+        for (int x = meeting; x != source; x = this->upTail[forwardArc[x]]) {
+            forwardArcs.push_back(forwardArc[x]);
+        }
+
+        for (auto it = forwardArcs.rbegin(); it != forwardArcs.rend(); ++it) {
+            this->unpack(metric, *it, true, path);
+        }
+
+        // Encontro -> destino (arcos para baixo)
+        for (int x = meeting; x != target; x = this->upTail[backwardArc[x]]) {
+            this->unpack(metric, backwardArc[x], false, path);
+        }
+    }
+
+    // Limpa apenas os ancestrais tocados
+    for (int x = source; x != -1; x = this->parent[x]) {
+        forwardCost[x] = INFINITY;
+        forwardArc[x] = -1;
+    }
+
+    for (int x = target; x != -1; x = this->parent[x]) {
+        backwardCost[x] = INFINITY;
+        backwardArc[x] = -1;
+    }
+
+    return path;
+}
+
+void ContractionHierarchy::upwardSearch(const Metric &metric, const int source, std::vector<double> &cost) const {
+    // Espaço de busca para cima da origem (ancestrais na árvore de eliminação), custos indexados por rank
+    cost[source] = 0.0;
+    for (int x = source; x != -1; x = this->parent[x]) {
+        if (cost[x] == INFINITY) continue;
+
+        for (int a = this->upFirst[x]; a < this->upFirst[x + 1]; a++) {
+            cost[this->upHead[a]] = std::min(cost[this->upHead[a]], cost[x] + metric.up[a]);
+        }
+    }
+}
+
+void ContractionHierarchy::oneToAll(const Metric &metric, const int idU, std::vector<double> &distances) const {
+    const int numNodes = static_cast<int>(this->order.size());
+
+    std::vector<double> cost(numNodes, INFINITY);
+    this->upwardSearch(metric, this->rank[idU], cost);
+
+    // Varredura linear do maior rank para o menor: os vizinhos superiores de um vértice já estão prontos
+    // e os arcos de cada rank são contíguos, então a memória é percorrida em ordem
+    for (int x = numNodes - 1; x >= 0; x--) {
+        double best = cost[x];
+        for (int a = this->upFirst[x]; a < this->upFirst[x + 1]; a++) {
+            best = std::min(best, cost[this->upHead[a]] + metric.down[a]);
+        }
+        cost[x] = best;
+    }
+
+    distances.resize(numNodes);
+    for (int x = 0; x < numNodes; x++) {
+        distances[this->order[x]] = cost[x];
+    }
+}
+
+void ContractionHierarchy::manyToMany(const Metric &metric, const std::vector<int> &sources,
+                                      const std::vector<int> &targets, std::vector<float> &matrix) const {
+    const int numNodes = static_cast<int>(this->order.size());
+    const int numSources = static_cast<int>(sources.size());
+    const int numTargets = static_cast<int>(targets.size());
+
+    // Seleção do RPHAST: os destinos e todos os seus ancestrais (contém os vizinhos superiores de cada um)
+    std::vector<char> selected(numNodes, 0);
+    std::vector<int> restricted;
+    for (const int target : targets) {
+        for (int x = this->rank[target]; x != -1 && !selected[x]; x = this->parent[x]) {
+            selected[x] = 1;
+            restricted.push_back(x);
+        }
+    }
+    std::sort(restricted.begin(), restricted.end(), std::greater<>());
+
+    matrix.assign(static_cast<std::size_t>(numSources) * numTargets, INFINITY);
+
+    // Cada origem é independente: uma varredura por origem, com o vetor de custos da própria thread
+    #pragma omp parallel
+    {
+        std::vector<double> cost(numNodes, INFINITY);
+
+        #pragma omp for schedule(dynamic, 8)
+        for (int i = 0; i < numSources; i++) {
+            const int source = this->rank[sources[i]];
+            this->upwardSearch(metric, source, cost);
+
+            for (const int x : restricted) {
+                double best = cost[x];
+                for (int a = this->upFirst[x]; a < this->upFirst[x + 1]; a++) {
+                    best = std::min(best, cost[this->upHead[a]] + metric.down[a]);
+                }
+                cost[x] = best;
+            }
+
+            float *row = &matrix[static_cast<std::size_t>(i) * numTargets];
+            for (int j = 0; j < numTargets; j++) {
+                row[j] = static_cast<float>(cost[this->rank[targets[j]]]);
+            }
+
+            // Limpa apenas o que foi tocado
+            for (int x = source; x != -1; x = this->parent[x]) cost[x] = INFINITY;
+            for (const int x : restricted) cost[x] = INFINITY;
+        }
+    }
+}
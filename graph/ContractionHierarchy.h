@@ -0,0 +1,88 @@
+#ifndef PROJETOCONCLUSAOCURSO_CONTRACTION_HIERARCHY_H
+#define PROJETOCONCLUSAOCURSO_CONTRACTION_HIERARCHY_H
+#include <vector>
+
+#include "ObstacleSnapshot.h"
+#include "RoadNetwork.h"
+
+
+// Customizable Contraction Hierarchy (CCH)
+// A ordem dos vértices (dissecção aninhada geométrica) e os atalhos dependem apenas da topologia,
+// então são calculados uma única vez. Os pesos (métrica) são obtidos na customização e podem ser
+// recalculados parcialmente quando arestas são bloqueadas/desbloqueadas pelos polígonos
+class ContractionHierarchy {
+public:
+    // Pesos de cada arco do grafo de atalhos, nos dois sentidos
+    struct Metric {
+        std::vector<double> up;         // Do vértice de menor rank para o de maior
+        std::vector<double> down;       // Do vértice de maior rank para o de menor
+        std::vector<int> upMid;         // Triângulo que gerou o peso (-1 se for uma aresta original)
+        std::vector<int> downMid;
+    };
+
+private:
+    struct Triangle {
+        int lowerArcU;                  // Arco (v, u), com v abaixo dos dois extremos
+        int lowerArcW;                  // Arco (v, w)
+    };
+
+    std::vector<int> rank;              // Vértice -> rank
+    std::vector<int> order;             // Rank -> vértice
+    std::vector<int> parent;            // Pai na árvore de eliminação (em ranks)
+
+    std::vector<int> upFirst;           // Arcos para cima de cada rank (CSR)
+    std::vector<int> upHead;            // Rank do extremo superior de cada arco
+    std::vector<int> upTail;            // Rank do extremo inferior de cada arco
+
+    std::vector<int> arcEdgeFirst;      // Arestas originais que compõem cada arco (CSR)
+    std::vector<int> arcEdges;
+    std::vector<int> edgeArc;           // Aresta original -> arco (-1 para laços)
+
+    std::vector<int> triangleFirst;     // Triângulos inferiores de cada arco (CSR)
+    std::vector<Triangle> triangles;
+
+    struct Dependent {
+        int arc;                        // Arco superior do triângulo
+        int triangle;                   // Índice do triângulo em "triangles"
+    };
+
+    std::vector<int> dependentFirst;    // Triângulos em que cada arco aparece como lado inferior (CSR)
+    std::vector<Dependent> dependents;
+
+    bool ready = false;
+
+    void computeOrder(const RoadNetwork &network);
+    void dissect(const RoadNetwork &network, std::vector<int> &nodes, int rankEnd, std::vector<int> &token, int &nextToken);
+    void contract(const RoadNetwork &network);
+    void buildTriangles();
+
+    int findArc(int lower, int upper) const;
+    bool recompute(Metric &metric, int arc, const RoadNetwork &network, const ObstacleSnapshot *obstacles) const;
+    void unpack(const Metric &metric, int arc, bool upward, std::vector<int> &path) const;
+    void upwardSearch(const Metric &metric, int source, std::vector<double> &cost) const;
+
+public:
+    void build(const RoadNetwork &network);
+    bool isReady() const { return this->ready; }
+
+    // Customização completa (obstacles == nullptr ignora os polígonos)
+    void customize(Metric &metric, const RoadNetwork &network, const ObstacleSnapshot *obstacles) const;
+    // Recalcula apenas os arcos afetados pelas arestas que mudaram de estado
+    int recustomize(Metric &metric, const RoadNetwork &network, const ObstacleSnapshot &obstacles,
+                    const std::vector<int> &changedEdges) const;
+
+    // Caminho (sem a origem) de idU até idV, vazio se não existir
+    std::vector<int> query(const Metric &metric, int idU, int idV) const;
+
+    // PHAST: distâncias de idU para todos os vértices (indexadas pelo vértice, infinito se inalcançável)
+    void oneToAll(const Metric &metric, int idU, std::vector<double> &distances) const;
+    // RPHAST: matriz |sources| x |targets| (uma linha por origem), varrendo só os ancestrais dos destinos
+    void manyToMany(const Metric &metric, const std::vector<int> &sources, const std::vector<int> &targets,
+                    std::vector<float> &matrix) const;
+
+    int getNumArcs() const { return static_cast<int>(this->upHead.size()); }
+    int getNumTriangles() const { return static_cast<int>(this->triangles.size()); }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_CONTRACTION_HIERARCHY_H
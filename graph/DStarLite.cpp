@@ -0,0 +1,226 @@
+#include "DStarLite.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace {
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+}
+
+double DStarLite::heuristic(const int node) const {
+    // A busca parte do destino, então a heurística estima a distância do agente até o vértice
+    return this->network->chordDistance(this->start, node);
+}
+
+double DStarLite::cost(const int edge) const {
+    return this->knownBlocked.test(edge) ? infinity : this->network->getEdgeWeight(edge);
+}
+
+DStarLite::Key DStarLite::calculateKey(const int node) const {
+    const double value = std::min(this->g[node], this->rhs[node]);
+    return {value + this->heuristic(node) + this->km, value};
+}
+
+void DStarLite::push(const int node) {
+    // Entradas antigas ficam no heap até serem descartadas, reconstrói quando houver muitas
+    if (this->heap.size() > 4 * this->g.size()) {
+        this->heap.clear();
+        for (int v = 0; v < static_cast<int>(this->g.size()); v++) {
+            if (this->inOpen[v]) this->heap.push_back({this->openKey[v], v});
+        }
+        std::make_heap(this->heap.begin(), this->heap.end(), std::greater<>());
+    }
+
+    this->heap.push_back({this->openKey[node], node});
+    std::push_heap(this->heap.begin(), this->heap.end(), std::greater<>());
+}
+
+void DStarLite::updateVertex(const int node) {
+    // Apenas vértices inconsistentes (g != rhs) ficam na fila
+    if (this->g[node] != this->rhs[node]) {
+        const Key key = this->calculateKey(node);
+        if (this->inOpen[node] && this->openKey[node] == key) return;
+
+        this->openKey[node] = key;
+        this->inOpen[node] = 1;
+        this->push(node);
+    } else {
+        this->inOpen[node] = 0;
+    }
+}
+
+double DStarLite::lookahead(const int node) const {
+    // rhs(u) = min(c(u, v) + g(v)) entre os sucessores de u
+    double best = infinity;
+    for (int e = this->network->beginEdge(node); e < this->network->endEdge(node); e++) {
+        best = std::min(best, this->cost(e) + this->g[this->network->getEdgeTarget(e)]);
+    }
+
+    return best;
+}
+
+void DStarLite::computeShortestPath() {
+    while (true) {
+        // Descarta as entradas que não correspondem mais à chave atual do vértice
+        while (!this->heap.empty() && (!this->inOpen[this->heap.front().id] ||
+                                       !(this->openKey[this->heap.front().id] == this->heap.front().key))) {
+            std::pop_heap(this->heap.begin(), this->heap.end(), std::greater<>());
+            this->heap.pop_back();
+        }
+
+        if (this->heap.empty()) break;
+
+        const QueueNode top = this->heap.front();
+        if (!(top.key < this->calculateKey(this->start)) && this->rhs[this->start] <= this->g[this->start]) break;
+
+        const int u = top.id;
+        const Key newKey = this->calculateKey(u);
+
+        // A chave ficou desatualizada com o movimento do agente (km), apenas reinsere
+        if (top.key < newKey) {
+            this->openKey[u] = newKey;
+            this->push(u);
+            continue;
+        }
+
+        std::pop_heap(this->heap.begin(), this->heap.end(), std::greater<>());
+        this->heap.pop_back();
+        this->inOpen[u] = 0;
+        this->expanded++;
+
+        if (this->g[u] > this->rhs[u]) {
+            // Sobreconsistente: o custo de u diminuiu, propaga para os predecessores
+            this->g[u] = this->rhs[u];
+
+            for (int i = this->network->beginInEdge(u); i < this->network->endInEdge(u); i++) {
+                const int e = this->network->getInEdge(i);
+                const int s = this->network->getEdgeSource(e);
+                if (s == this->goal) continue;
+
+                this->rhs[s] = std::min(this->rhs[s], this->cost(e) + this->g[u]);
+                this->updateVertex(s);
+            }
+        } else {
+            // Subconsistente: o custo de u aumentou, predecessores que dependiam dele são recalculados
+            const double oldG = this->g[u];
+            this->g[u] = infinity;
+
+            for (int i = this->network->beginInEdge(u); i < this->network->endInEdge(u); i++) {
+                const int e = this->network->getInEdge(i);
+                const int s = this->network->getEdgeSource(e);
+
+                if (s != this->goal && this->rhs[s] == this->cost(e) + oldG) {
+                    this->rhs[s] = this->lookahead(s);
+                }
+                this->updateVertex(s);
+            }
+
+            this->updateVertex(u);
+        }
+    }
+}
+
+void DStarLite::synchronize(const ObstacleSnapshot &obstacles) {
+    // Arestas cujo estado difere do conhecido: desbloqueadas (estavam na lista anterior) ou bloqueadas agora
+    std::vector<int> changed;
+    for (const int edge : this->knownBlockedEdges) {
+        if (!obstacles.isEdgeBlocked(edge)) changed.push_back(edge);
+    }
+
+    for (const int edge : obstacles.getBlockedEdges()) {
+        if (!this->knownBlocked.test(edge)) changed.push_back(edge);
+    }
+
+    for (const int edge : changed) {
+        const double oldCost = this->cost(edge);
+        if (obstacles.isEdgeBlocked(edge)) this->knownBlocked.set(edge);
+        else this->knownBlocked.reset(edge);
+        const double newCost = this->cost(edge);
+
+        const int u = this->network->getEdgeSource(edge);
+        const int v = this->network->getEdgeTarget(edge);
+        if (u == this->goal) continue;
+
+        if (oldCost > newCost) {
+            this->rhs[u] = std::min(this->rhs[u], newCost + this->g[v]);
+        } else if (this->rhs[u] == oldCost + this->g[v]) {
+            this->rhs[u] = this->lookahead(u);
+        }
+
+        this->updateVertex(u);
+    }
+
+    this->knownBlockedEdges = obstacles.getBlockedEdges();
+}
+
+void DStarLite::reset(const RoadNetwork &network, const ObstacleSnapshot &obstacles, const int idStart, const int idGoal) {
+    const int numNodes = network.getNumNodes();
+
+    this->network = &network;
+    this->start = idStart;
+    this->last = idStart;
+    this->goal = idGoal;
+    this->km = 0.0;
+    this->expanded = 0;
+
+    this->g.assign(numNodes, infinity);
+    this->rhs.assign(numNodes, infinity);
+    this->openKey.assign(numNodes, {infinity, infinity});
+    this->inOpen.assign(numNodes, 0);
+    this->heap.clear();
+
+    this->knownBlocked.resize(network.getNumEdges());
+    this->knownBlockedEdges = obstacles.getBlockedEdges();
+    for (const int edge : this->knownBlockedEdges) {
+        this->knownBlocked.set(edge);
+    }
+
+    this->rhs[idGoal] = 0.0;
+    this->updateVertex(idGoal);
+}
+
+std::vector<int> DStarLite::plan(const ObstacleSnapshot &obstacles, const int idStart) {
+    if (this->network == nullptr) {
+        return {};
+    }
+
+    // As chaves antigas continuam limites inferiores se somarmos o quanto o agente andou
+    if (idStart != this->last) {
+        this->start = idStart;
+        this->km += this->heuristic(this->last);
+        this->last = idStart;
+    }
+
+    this->synchronize(obstacles);
+    this->computeShortestPath();
+
+    std::vector<int> path;
+    if (this->rhs[this->start] == infinity) {
+        return path;
+    }
+
+    // Segue o sucessor com menor c(u, v) + g(v) até o destino
+    const int numNodes = static_cast<int>(this->g.size());
+    for (int current = this->start; current != this->goal;) {
+        int next = -1;
+        double best = infinity;
+        for (int e = this->network->beginEdge(current); e < this->network->endEdge(current); e++) {
+            const double value = this->cost(e) + this->g[this->network->getEdgeTarget(e)];
+            if (value < best) {
+                best = value;
+                next = this->network->getEdgeTarget(e);
+            }
+        }
+
+        if (next == -1 || static_cast<int>(path.size()) >= numNodes) {
+            return {};
+        }
+
+        path.push_back(next);
+        current = next;
+    }
+
+    return path;
+}
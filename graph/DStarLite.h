@@ -0,0 +1,73 @@
+#ifndef PROJETOCONCLUSAOCURSO_D_STAR_LITE_H
+#define PROJETOCONCLUSAOCURSO_D_STAR_LITE_H
+#include <vector>
+
+#include "ObstacleSnapshot.h"
+#include "RoadNetwork.h"
+#include "../helper/Bitmap.h"
+
+
+// Planejador incremental D* Lite (Koenig e Likhachev) para um destino fixo
+// A busca é feita do destino para o agente e a árvore é mantida entre os ticks: quando arestas são
+// bloqueadas/desbloqueadas apenas os vértices cujo custo depende delas são reprocessados
+class DStarLite {
+    struct Key {
+        double primary;
+        double secondary;
+
+        bool operator<(const Key &other) const {
+            return primary < other.primary || (primary == other.primary && secondary < other.secondary);
+        }
+
+        bool operator==(const Key &other) const {
+            return primary == other.primary && secondary == other.secondary;
+        }
+    };
+
+    struct QueueNode {
+        Key key;
+        int id;
+
+        bool operator>(const QueueNode &other) const { return other.key < key; }
+    };
+
+    const RoadNetwork *network = nullptr;
+    int start = -1;
+    int goal = -1;
+    int last = -1;                      // Posição do agente no último replanejamento (ajuste de km)
+    double km = 0.0;                    // Acúmulo da heurística conforme o agente se move
+
+    std::vector<double> g;
+    std::vector<double> rhs;            // Custo previsto a partir dos sucessores (one-step lookahead)
+    std::vector<Key> openKey;           // Chave atual de cada vértice na fila
+    std::vector<char> inOpen;
+    std::vector<QueueNode> heap;        // Min-heap com remoção preguiçosa (entradas com chave antiga são descartadas)
+
+    Bitmap knownBlocked;                // Arestas bloqueadas conforme a última sincronização
+    std::vector<int> knownBlockedEdges;
+
+    long long expanded = 0;             // Vértices expandidos desde o início do planejamento
+
+    double heuristic(int node) const;
+    double cost(int edge) const;
+    Key calculateKey(int node) const;
+
+    void push(int node);
+    void updateVertex(int node);
+    double lookahead(int node) const;
+    void computeShortestPath();
+    void synchronize(const ObstacleSnapshot &obstacles);
+
+public:
+    // Inicia uma nova árvore para o destino (as arestas bloqueadas vêm da fotografia atual)
+    void reset(const RoadNetwork &network, const ObstacleSnapshot &obstacles, int idStart, int idGoal);
+
+    // Caminho (sem a origem) de idStart até o destino, reparando a árvore com as mudanças da fotografia
+    std::vector<int> plan(const ObstacleSnapshot &obstacles, int idStart);
+
+    int getGoal() const { return this->goal; }
+    long long getExpanded() const { return this->expanded; }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_D_STAR_LITE_H
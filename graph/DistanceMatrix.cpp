@@ -0,0 +1,90 @@
+#include "DistanceMatrix.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+
+std::vector<int> DistanceMatrix::sampleNodes(const RoadNetwork &network, const int count, Philox &rng) {
+    std::vector<int> all(network.getNumNodes());
+    std::iota(all.begin(), all.end(), 0);
+
+    if (count <= 0 || count >= network.getNumNodes()) {
+        return all;
+    }
+
+    // Fisher-Yates parcial: apenas as count primeiras posições são sorteadas
+    for (int i = 0; i < count; i++) {
+        std::swap(all[i], all[rng.uniformInt(i, network.getNumNodes() - 1)]);
+    }
+    all.resize(count);
+
+    return all;
+}
+
+void DistanceMatrix::buildIndex() {
+    this->nodeIndex.assign(this->numNetworkNodes, -1);
+    for (int i = 0; i < static_cast<int>(this->nodes.size()); i++) {
+        this->nodeIndex[this->nodes[i]] = i;
+    }
+}
+
+void DistanceMatrix::assign(const RoadNetwork &network, std::vector<int> newNodes, std::vector<float> newDistances) {
+    this->numNetworkNodes = network.getNumNodes();
+    this->networkFingerprint = network.getFingerprint();
+    this->nodes = std::move(newNodes);
+    this->distances = std::move(newDistances);
+    this->buildIndex();
+}
+
+bool DistanceMatrix::save(const std::string &path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open() || this->isEmpty()) {
+        return false;
+    }
+
+    const std::int32_t header[] = {this->numNetworkNodes, this->size()};
+    file.write(reinterpret_cast<const char *>(&this->networkFingerprint), sizeof(this->networkFingerprint));
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(this->nodes.data()), this->nodes.size() * sizeof(int));
+    file.write(reinterpret_cast<const char *>(this->distances.data()), this->distances.size() * sizeof(float));
+
+    return file.good();
+}
+
+bool DistanceMatrix::load(const std::string &path, const RoadNetwork &network) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // A matriz só vale para a malha em que foi calculada (mesmo número de vértices não basta)
+    std::uint64_t fingerprint;
+    std::int32_t header[2];
+    file.read(reinterpret_cast<char *>(&fingerprint), sizeof(fingerprint));
+    file.read(reinterpret_cast<char *>(header), sizeof(header));
+    if (!file || fingerprint != network.getFingerprint() || header[0] != network.getNumNodes() || header[1] <= 0 ||
+        header[1] > header[0]) {
+        return false;
+    }
+
+    std::vector<int> newNodes(header[1]);
+    std::vector<float> newDistances(static_cast<std::size_t>(header[1]) * header[1]);
+    file.read(reinterpret_cast<char *>(newNodes.data()), newNodes.size() * sizeof(int));
+    file.read(reinterpret_cast<char *>(newDistances.data()), newDistances.size() * sizeof(float));
+    if (!file) {
+        return false;
+    }
+
+    for (const int node : newNodes) {
+        if (node < 0 || node >= header[0]) return false;
+    }
+
+    this->assign(network, std::move(newNodes), std::move(newDistances));
+    return true;
+}
+
+std::size_t DistanceMatrix::memoryUsage() const {
+    return this->nodes.capacity() * sizeof(int) + this->nodeIndex.capacity() * sizeof(int) +
+           this->distances.capacity() * sizeof(float);
+}
@@ -0,0 +1,46 @@
+#ifndef PROJETOCONCLUSAOCURSO_DISTANCE_MATRIX_H
+#define PROJETOCONCLUSAOCURSO_DISTANCE_MATRIX_H
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RoadNetwork.h"
+#include "../helper/Philox.h"
+
+
+// Matriz de distâncias (sem polígonos) entre um conjunto de vértices da malha
+// Guardada em float (4 bytes por par) e em disco no formato binário: cabeçalho, vértices e a matriz
+class DistanceMatrix {
+    int numNetworkNodes = 0;
+    std::uint64_t networkFingerprint = 0;   // RoadNetwork::getFingerprint da malha em que foi calculada
+    std::vector<int> nodes;             // Vértice de cada linha/coluna
+    std::vector<int> nodeIndex;         // Vértice -> linha/coluna (-1 se não estiver na matriz)
+    std::vector<float> distances;       // Linha por origem
+
+    void buildIndex();
+
+public:
+    // Sorteia count vértices distintos (todos se count <= 0 ou maior que a malha)
+    static std::vector<int> sampleNodes(const RoadNetwork &network, int count, Philox &rng);
+
+    void assign(const RoadNetwork &network, std::vector<int> newNodes, std::vector<float> newDistances);
+
+    bool save(const std::string &path) const;
+    bool load(const std::string &path, const RoadNetwork &network);
+
+    bool isEmpty() const { return this->nodes.empty(); }
+    int size() const { return static_cast<int>(this->nodes.size()); }
+    int getNode(const int i) const { return this->nodes[i]; }
+    int indexOf(const int node) const { return node < static_cast<int>(this->nodeIndex.size()) ? this->nodeIndex[node] : -1; }
+
+    float getDistance(const int i, const int j) const {
+        return this->distances[static_cast<std::size_t>(i) * this->nodes.size() + j];
+    }
+    bool isReachable(const int i, const int j) const { return std::isfinite(this->getDistance(i, j)); }
+
+    std::size_t memoryUsage() const;
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_DISTANCE_MATRIX_H
@@ -4,241 +4,646 @@
 
 #include "DynamicGraph.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <queue>
-#include <random>
 #include <omp.h>
 
-#include "../helper/PointHelper.h"
+DynamicGraph::DynamicGraph() : DynamicGraph(std::make_shared<StaticGraph>(), std::make_shared<UniformGrid>()) {}
 
-DynamicGraph::DynamicGraph()
-    : uniformGrid(UniformGrid(0.01)),
-      cellSize(0.01),
-      minLon(std::numeric_limits<double>::infinity()),
-      maxLon(-std::numeric_limits<double>::infinity()),
-      minLat(std::numeric_limits<double>::infinity()),
-      maxLat(-std::numeric_limits<double>::infinity()) {}
+DynamicGraph::DynamicGraph(std::shared_ptr<StaticGraph> road, std::shared_ptr<const UniformGrid> grid) :
+    road(std::move(road)), grid(std::move(grid)) {
+    this->polygonIndex.reset(this->grid->getCellSize());
+}
+
+DynamicGraph DynamicGraph::createTrial(const std::uint32_t newTrial) const {
+    // Compartilha a malha e a grade; apenas as configurações das buscas são copiadas
+    DynamicGraph trialGraph(this->road, this->grid);
+    trialGraph.unidirectionalQueue = this->unidirectionalQueue;
+    trialGraph.bidirectionalQueue = this->bidirectionalQueue;
+    trialGraph.geometricHeuristic = this->geometricHeuristic;
+    trialGraph.routeCache.setEnabled(this->routeCache.isEnabled());
+    trialGraph.setRandomSeed(this->seed, newTrial);
+
+    return trialGraph;
+}
+
+DynamicGraph DynamicGraph::withPolygonRadius(const double polygonRadius) const {
+    DynamicGraph radiusGraph = this->createTrial(this->trial);
+
+    if (this->chooseCellSize(polygonRadius) != this->grid->getCellSize()) {
+        radiusGraph.grid = radiusGraph.buildGrid(polygonRadius);
+        radiusGraph.polygonIndex.reset(radiusGraph.grid->getCellSize());
+    }
+
+    return radiusGraph;
+}
+
+void DynamicGraph::addTrialStatistics(const DynamicGraph &trialGraph) {
+    this->customizationUs += trialGraph.customizationUs;
+    this->customizationCount += trialGraph.customizationCount;
+    this->routeCache.addStats(trialGraph.routeCache.getStats());
+}
 
 void DynamicGraph::addPoint(const long long id, const double x, const double y) {
     // Adiciona o ponto corrigindo os limites geográficos do mapa
-    this->idToPoint[id] = Point(id, x, y);
-    this->adj[id] = {};
+    this->road->network.addNode(id, x, y);
 
-    minLon = std::min(minLon, x);
-    maxLon = std::max(maxLon, x);
-    minLat = std::min(minLat, y);
-    maxLat = std::max(maxLat, y);
+    this->road->minLon = std::min(this->road->minLon, x);
+    this->road->maxLon = std::max(this->road->maxLon, x);
+    this->road->minLat = std::min(this->road->minLat, y);
+    this->road->maxLat = std::max(this->road->maxLat, y);
 }
 
 void DynamicGraph::addEdge(const long long idU, const long long idV, const double dist) {
-    // Adiciona a aresta na lista de adjacência e na grade uniforme
-    Point *pointU = &idToPoint[idU];
-    Point *pointV = &idToPoint[idV];
+    // A aresta fica pendente até o congelamento da malha
+    this->road->network.addEdge(idU, idV, dist);
+}
+
+double DynamicGraph::chooseCellSize(const double polygonRadius) const {
+    // Maior deslocamento de cada aresta em um dos eixos (em graus)
+    std::vector<double> extents(this->road->network.getNumEdges());
+    for (int e = 0; e < this->road->network.getNumEdges(); e++) {
+        const int u = this->road->network.getEdgeSource(e);
+        const int v = this->road->network.getEdgeTarget(e);
+        extents[e] = std::max(std::abs(this->road->network.getX(u) - this->road->network.getX(v)),
+                              std::abs(this->road->network.getY(u) - this->road->network.getY(v)));
+    }
+
+    double medianEdge = 0.0;
+    if (!extents.empty()) {
+        std::nth_element(extents.begin(), extents.begin() + extents.size() / 2, extents.end());
+        medianEdge = extents[extents.size() / 2];
+    }
 
-    this->adj[idU].emplace_back(pointU, pointV, dist);
-    this->uniformGrid.insertEdge(&this->adj[idU].back());
+    // Próxima do diâmetro típico dos polígonos (poucas células por polígono) e nunca menor que a aresta mediana
+    // (cada aresta atravessa poucas células). Sem o raio, algumas arestas medianas por célula
+    double size = polygonRadius > 0.0 ? 2.0 * polygonRadius : 4.0 * medianEdge;
+    size = std::max(size, medianEdge);
+
+    // Mapas grandes: limita a quantidade de células (os blocos vazios quase não ocupam memória)
+    const double width = this->road->maxLon - this->road->minLon;
+    const double height = this->road->maxLat - this->road->minLat;
+    size = std::max(size, std::sqrt(width * height / maxGridCells));
+
+    // O centro do polígono é sorteado a maxMoveDistance das bordas da célula
+    return std::max(size, 4.0 * Hexagon::maxMoveDistance);
 }
 
-void DynamicGraph::addPolygon(const Polygon &polygon) {
-    // Adiciona o polígono
+std::shared_ptr<const UniformGrid> DynamicGraph::buildGrid(const double polygonRadius) const {
+    // Insere as arestas (pelos índices) na grade, com a resolução escolhida pelos dados
+    auto newGrid = std::make_shared<UniformGrid>(this->chooseCellSize(polygonRadius));
+
+    for (int e = 0; e < this->road->network.getNumEdges(); e++) {
+        newGrid->insertEdge(e, this->road->network.getPoint(this->road->network.getEdgeSource(e)),
+                            this->road->network.getPoint(this->road->network.getEdgeTarget(e)));
+    }
+
+    // Os limites do mapa já são conhecidos: a grade passa para os blocos densos/esparsos
+    newGrid->finalize();
+    return newGrid;
+}
+
+void DynamicGraph::freeze(const double polygonRadius) {
+    // Monta o CSR e a grade das arestas
+    this->road->network.freeze();
+
+    this->grid = this->buildGrid(polygonRadius);
+    this->polygonIndex.reset(this->grid->getCellSize());
+}
+
+void DynamicGraph::addPolygon(const Hexagon &polygon) {
+    // Adiciona o polígono (a fotografia dos bloqueios é refeita no próximo uso)
     this->polygons.push_back(polygon);
+    this->polygonIndex.add(polygon);
+    this->obstaclesDirty = true;
 }
 
-void DynamicGraph::updatePolygonsPosition() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dist(-Polygon::maxMoveDistance, Polygon::maxMoveDistance);
+void DynamicGraph::setRandomSeed(const std::uint64_t newSeed, const std::uint32_t newTrial) {
+    this->seed = newSeed;
+    this->trial = newTrial;
+    this->motionTick = 0;
+}
 
-    #pragma omp parallel for
-    for (auto &polygon : this->polygons) {
-        bool validMove = false;
-        int attempts = 0;
-
-        // Enquanto não for um movimento válido (célula que possui arestas), tenta movimentar o polígono novamente
-        // Até atingir um limite máximo de 10 tentativas
-        while (!validMove && attempts < 10) {
-            const double ax = dist(gen) * Polygon::acceleration;
-            const double ay = dist(gen) * Polygon::acceleration;
-
-            polygon.setVelocityX(Polygon::inertia * polygon.getVelocityX() + ax);
-            polygon.setVelocityY(Polygon::inertia * polygon.getVelocityY() + ay);
-
-            const double speed = std::sqrt(polygon.getVelocityX() * polygon.getVelocityX() + polygon.getVelocityY() * polygon.getVelocityY());
-            if (speed > Polygon::maxMoveDistance) {
-                polygon.setVelocityX(polygon.getVelocityX() * (Polygon::maxMoveDistance / speed));
-                polygon.setVelocityY(polygon.getVelocityY() * (Polygon::maxMoveDistance / speed));
-            }
+void DynamicGraph::clearPolygons() {
+    this->polygons.clear();
+    this->polygonIndex.reset(this->grid->getCellSize());
+    this->obstaclesDirty = true;
+}
+
+void DynamicGraph::refreshObstacleSnapshot() {
+    if (!this->obstaclesDirty) return;
 
-            validMove = polygon.updatePosition(polygon.getVelocityX(), polygon.getVelocityY(), this->getUniformGrid());
-            attempts++;
+    this->polygonBatch.assign(this->polygons);
+    this->obstacles.rebuild(this->road->network, *this->grid, this->polygonBatch, this->polygonIndex);
+    this->obstaclesDirty = false;
+
+    // Acumula as arestas que mudaram de estado, a CCH é recustomizada apenas quando for consultada
+    if (this->dynamicMetricReady) {
+        for (const int edge : this->obstacles.getChangedEdges()) {
+            if (!this->pendingCustomizationBits.test(edge)) {
+                this->pendingCustomizationBits.set(edge);
+                this->pendingCustomization.push_back(edge);
+            }
         }
     }
 }
 
-std::vector<long long> DynamicGraph::findPathAStar(const long long idU, const long long idV) {
-    // A* que retorna o caminho encontrado
-    std::vector<long long> path;
+void DynamicGraph::applyPendingCustomization() {
+    if (this->pendingCustomization.empty()) return;
 
-    if (!this->idToPoint.contains(idU) || !this->idToPoint.contains(idV)) {
-        return path;
+    // Recalcula apenas os atalhos afetados pelas arestas bloqueadas/desbloqueadas
+    const auto start = std::chrono::high_resolution_clock::now();
+    this->road->hierarchy.recustomize(this->dynamicMetric, this->road->network, this->obstacles, this->pendingCustomization);
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    this->customizationUs += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    this->customizationCount++;
+
+    for (const int edge : this->pendingCustomization) {
+        this->pendingCustomizationBits.reset(edge);
+    }
+    this->pendingCustomization.clear();
+}
+
+void DynamicGraph::prepareContractionHierarchy() {
+    if (this->dynamicMetricReady) return;
+
+    // A métrica dinâmica parte da fotografia atual, as próximas mudanças são aplicadas por tick
+    this->refreshObstacleSnapshot();
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Ordem, atalhos e a métrica sem polígonos dependem só da topologia (compartilhados entre as execuções)
+    if (!this->road->hierarchy.isReady()) {
+        this->road->hierarchy.build(this->road->network);
+        this->road->hierarchy.customize(this->road->staticMetric, this->road->network, nullptr);
     }
 
-    const Point& target = this->idToPoint.at(idV);
+    // A métrica com os bloqueios é de cada execução
+    this->road->hierarchy.customize(this->dynamicMetric, this->road->network, &this->obstacles);
+    this->pendingCustomizationBits.resize(this->road->network.getNumEdges());
+    this->dynamicMetricReady = true;
 
-    std::unordered_map<long long, double> gCosts;
-    std::unordered_map<long long, long long> previous;
-    std::priority_queue<AStarNode, std::vector<AStarNode>, std::greater<>> pq;
+    const auto end = std::chrono::high_resolution_clock::now();
+    this->hierarchyBuildUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
 
-    for (const auto& [id, point] : this->idToPoint) {
-        gCosts[id] = std::numeric_limits<double>::infinity();
-        previous[id] = -1;
+bool DynamicGraph::prepareLandmarks(const int count, const std::string &cachePath) {
+    if (this->road->landmarks.isReady() && this->road->landmarks.getNumLandmarks() == std::min(count, this->road->network.getNumNodes())) {
+        return true;
     }
 
-    gCosts[idU] = 0.0;
-    double initialHCost = PointHelper::haversineDistance(this->idToPoint.at(idU), target);
-    pq.emplace(idU, 0.0, initialHCost);
+    const auto start = std::chrono::high_resolution_clock::now();
 
-    while (!pq.empty()) {
-        const AStarNode current = pq.top();
-        pq.pop();
+    // Reaproveita as tabelas salvas por uma execução anterior, se forem da mesma malha e quantidade
+    bool loaded = !cachePath.empty() && this->road->landmarks.load(cachePath, this->road->network) &&
+                  this->road->landmarks.getNumLandmarks() == std::min(count, this->road->network.getNumNodes());
 
-        const long long u = current.id;
+    if (!loaded) {
+        this->road->landmarks.select(this->road->network, count);
+        if (!cachePath.empty()) this->road->landmarks.save(cachePath);
+    }
 
-        if (u == idV) {
-            break;
-        }
+    const auto end = std::chrono::high_resolution_clock::now();
+    this->landmarksBuildUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    return loaded;
+}
 
-        if (current.gCost > gCosts[u]) {
-            continue;
+void DynamicGraph::prepareQueries(const SearchAlgorithm algorithm) {
+    this->refreshObstacleSnapshot();
+
+    if (algorithm == ContractionHierarchies) {
+        this->prepareContractionHierarchy();
+        this->applyPendingCustomization();
+    } else if (algorithm == AltAStar && !this->road->landmarks.isReady()) {
+        this->prepareLandmarks();
+    }
+}
+
+long long DynamicGraph::computeDistanceMatrix(const std::vector<int> &nodes, DistanceMatrix &matrix,
+                                             const bool useHierarchy) {
+    if (useHierarchy) this->prepareContractionHierarchy();
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<float> distances;
+    if (useHierarchy) {
+        this->road->hierarchy.manyToMany(this->road->staticMetric, nodes, nodes, distances);
+    } else {
+        // Sem pré-processamento: uma árvore de caminhos mínimos completa por linha
+        const int count = static_cast<int>(nodes.size());
+        distances.resize(static_cast<std::size_t>(count) * count);
+
+        #pragma omp parallel
+        {
+            std::vector<double> tree;
+
+            #pragma omp for schedule(dynamic, 4)
+            for (int i = 0; i < count; i++) {
+                Landmarks::dijkstra(this->road->network, nodes[i], false, tree);
+                for (int j = 0; j < count; j++) {
+                    distances[static_cast<std::size_t>(i) * count + j] = static_cast<float>(tree[nodes[j]]);
+                }
+            }
         }
+    }
+    matrix.assign(this->road->network, nodes, std::move(distances));
 
-        // Para cada arestas do vértice atual
-        for (const Edge& edge : this->adj[u]) {
-            const long long v = edge.getV()->getId();
-            const double weight = edge.getDist();
-            const double newGCost = gCosts[u] + weight;
+    const auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
 
-            // Se encontrou um custo melhor, adiciona na fila
-            if (newGCost < gCosts[v]) {
-                gCosts[v] = newGCost;
-                previous[v] = u;
+void DynamicGraph::updatePolygonsPosition(const int ticks) {
+    const int numPolygons = static_cast<int>(this->polygons.size());
 
-                // Utiliza a heurística de haversine para h(n)
-                const double hCost = PointHelper::haversineDistance(this->idToPoint.at(v), target);
-                const double fCost = newGCost + hCost;
+    // O movimento de um polígono depende apenas dele e da grade, então cada um avança todos os ticks de uma vez
+    #pragma omp parallel for
+    for (int p = 0; p < numPolygons; p++) {
+        Hexagon &polygon = this->polygons[p];
+
+        for (int t = 0; t < ticks; t++) {
+            // Sequência própria do polígono neste tick: o resultado não depende da thread nem da ordem
+            Philox rng(this->seed, Philox::PolygonMotion, p, this->motionTick + t, this->trial);
+            bool validMove = false;
+            int attempts = 0;
+
+            // Enquanto não for um movimento válido (célula que possui arestas), tenta movimentar o polígono novamente
+            // Até atingir um limite máximo de 10 tentativas
+            while (!validMove && attempts < 10) {
+                const double ax = rng.uniform(-Hexagon::maxMoveDistance, Hexagon::maxMoveDistance) * Hexagon::acceleration;
+                const double ay = rng.uniform(-Hexagon::maxMoveDistance, Hexagon::maxMoveDistance) * Hexagon::acceleration;
+
+                polygon.setVelocityX(Hexagon::inertia * polygon.getVelocityX() + ax);
+                polygon.setVelocityY(Hexagon::inertia * polygon.getVelocityY() + ay);
+
+                const double speed = std::sqrt(polygon.getVelocityX() * polygon.getVelocityX() + polygon.getVelocityY() * polygon.getVelocityY());
+                if (speed > Hexagon::maxMoveDistance) {
+                    polygon.setVelocityX(polygon.getVelocityX() * (Hexagon::maxMoveDistance / speed));
+                    polygon.setVelocityY(polygon.getVelocityY() * (Hexagon::maxMoveDistance / speed));
+                }
 
-                pq.emplace(v, newGCost, fCost);
+                validMove = polygon.updatePosition(polygon.getVelocityX(), polygon.getVelocityY(), this->getUniformGrid());
+                attempts++;
             }
         }
     }
 
-    // Se não chegou ao destino retorna um caminho vazio
-    if (!previous.contains(idV) || previous.at(idV) == -1) {
-        return path;
-    }
+    this->motionTick += ticks;
 
-    // Caso contrário reconstroi o caminho a partir do vetor de previous
-    long long current = idV;
-    while (current != idU && previous.at(current) != -1) {
-        path.push_back(current);
-        current = previous.at(current);
-    }
+    // Só os polígonos que cruzaram o limite de uma célula (ou foram arrastados) mudam no índice
+    this->polygonIndex.update(this->polygons);
 
-    // Inverte o caminho e retorna ele
-    std::reverse(path.begin(), path.end());
-    return path;
+    // Uma única fotografia dos bloqueios por tick, lida por todas as buscas e agentes
+    this->obstaclesDirty = true;
+    this->refreshObstacleSnapshot();
 }
 
-std::vector<long long> DynamicGraph::findPathAStarConsideringPolygons(const long long idU, const long long idV) {
-    // Similar ao anterior porem considerando os polígonos
-    std::vector<long long> path;
+bool DynamicGraph::isStepBlocked(const int u, const int v) const {
+    if (this->obstacles.isNodeBlocked(u) || this->obstacles.isNodeBlocked(v)) return true;
 
-    if (!this->idToPoint.contains(idU) || !this->idToPoint.contains(idV)) {
-        return path;
-    }
+    const int edge = this->road->network.findEdge(u, v);
+    return edge >= 0 && this->obstacles.isEdgeBlocked(edge);
+}
 
-    const Point& target = this->idToPoint.at(idV);
+bool DynamicGraph::isCellOccupied(const Cell &cell) const {
+    const int cellIndex = this->grid->getCellIndex(cell);
+    if (cellIndex < 0 || this->obstaclesDirty) return this->polygonIndex.isCellOccupied(cell);
 
-    // Se o destino está obstruído, retorna sem considerar os polígonos
-    for (const Polygon& polygon : this->polygons) {
-        if (PointHelper::pointInConvexPolygon(polygon.getPoints(), target)) {
-            return findPathAStar(idU, idV);
-        }
+    return this->obstacles.isCellOccupied(cellIndex);
+}
+
+void DynamicGraph::setGeometricHeuristic(const GeometricHeuristic heuristic) {
+    this->geometricHeuristic = heuristic;
+}
+
+void DynamicGraph::setRouteCacheEnabled(const bool enabled) {
+    this->routeCache.clear();
+    this->routeCache.setEnabled(enabled);
+}
+
+void DynamicGraph::setSearchQueues(const SearchContext::QueueType unidirectional, const SearchContext::QueueType bidirectional) {
+    this->unidirectionalQueue = unidirectional;
+    this->bidirectionalQueue = bidirectional;
+}
+
+SearchContext &DynamicGraph::getSearchContext(const int direction) {
+    // Uma área de trabalho por thread (e por sentido da busca), alocada no primeiro uso
+    // e reaproveitada nas consultas seguintes
+    thread_local SearchContext contexts[2];
+    return contexts[direction];
+}
+
+SearchContext::QueueType DynamicGraph::chooseQueue(const SearchContext::QueueType preferred, const bool useLandmarks) const {
+    // O radix heap exige chaves monótonas: os landmarks são sempre consistentes, as heurísticas geométricas apenas
+    // quando nenhum peso é menor que a distância geométrica da aresta (senão usa o heap 4-ário)
+    if (preferred == SearchContext::RadixHeap && !useLandmarks && !this->road->network.hasGeometricWeights()) {
+        return SearchContext::QuaternaryHeap;
     }
 
-    std::unordered_map<long long, double> gCosts;
-    std::unordered_map<long long, long long> previous;
-    std::priority_queue<AStarNode, std::vector<AStarNode>, std::greater<>> pq;
+    return preferred;
+}
 
-    for (const auto& [id, point] : this->idToPoint) {
-        gCosts[id] = std::numeric_limits<double>::infinity();
-        previous[id] = -1;
+void DynamicGraph::evaluateHeuristic(const int *nodes, const int count, const int target, const bool useLandmarks,
+                                     double *out) const {
+    // Limite inferior dos landmarks ou distância geométrica (kernels em lote da malha)
+    if (useLandmarks) {
+        for (int i = 0; i < count; i++) out[i] = this->road->landmarks.lowerBound(nodes[i], target);
+    } else if (this->geometricHeuristic == Chord) {
+        this->road->network.chordDistances(nodes, count, target, out);
+    } else {
+        this->road->network.haversineDistances(nodes, count, target, out);
     }
+}
 
-    gCosts[idU] = 0.0;
-    double initialHCost = PointHelper::haversineDistance(this->idToPoint.at(idU), target);
-    pq.emplace(idU, 0.0, initialHCost);
+double DynamicGraph::geometricDistance(const int idU, const int idV) const {
+    return this->geometricHeuristic == Chord ? this->road->network.chordDistance(idU, idV)
+                                             : this->road->network.haversineDistance(idU, idV);
+}
 
-    while (!pq.empty()) {
-        const AStarNode current = pq.top();
-        pq.pop();
+std::vector<int> DynamicGraph::searchAStar(const int idU, const int idV, const bool considerPolygons, const bool useLandmarks) {
+    // Vizinhos melhorados pela expansão atual, a heurística deles é calculada de uma vez
+    thread_local std::vector<int> improved;
+    thread_local std::vector<double> hCosts;
+
+    // Reaproveita a área de trabalho da thread (reinício em O(1))
+    SearchContext &context = getSearchContext();
+    context.reset(this->road->network.getNumNodes(), this->chooseQueue(this->unidirectionalQueue, useLandmarks));
+
+    context.update(idU, 0.0, -1);
+    double initialHCost;
+    this->evaluateHeuristic(&idU, 1, idV, useLandmarks, &initialHCost);
+    // Heurística infinita: os landmarks provam que o destino é inalcançável
+    if (std::isfinite(initialHCost)) {
+        context.push(idU, initialHCost);
+    }
 
-        const long long u = current.id;
+    while (!context.queueEmpty()) {
+        const int u = context.pop();
 
         if (u == idV) {
             break;
         }
 
-        if (current.gCost > gCosts[u]) {
-            continue;
+        const double gCost = context.getCost(u);
+        context.markSettled();
+        improved.clear();
+
+        // Para cada arestas do vértice atual
+        for (int e = this->road->network.beginEdge(u); e < this->road->network.endEdge(u); e++) {
+            // Essa aresta intersecta algum polígono e não pode ser utilizada
+            if (considerPolygons && this->obstacles.isEdgeBlocked(e)) {
+                continue;
+            }
+
+            const int v = this->road->network.getEdgeTarget(e);
+            const double weight = this->road->network.getEdgeWeight(e);
+            const double newGCost = gCost + weight;
+
+            // Se encontrou um custo melhor, atualiza e deixa para inserir na fila depois da heurística
+            if (newGCost < context.getCost(v)) {
+                context.update(v, newGCost, u);
+                improved.push_back(v);
+            }
         }
 
-        for (const Edge& edge : this->adj[u]) {
-            const long long v = edge.getV()->getId();
-            const double weight = edge.getDist();
-
-            // Se a aresta intersecta algum polígono
-            bool edgeIntersectsPolygon = false;
-            #pragma omp parallel for
-            for (const Polygon& polygon : this->polygons) {
-                if (!edgeIntersectsPolygon) {
-                    if (PointHelper::pointInConvexPolygon(polygon.getPoints(), *edge.getU()) ||
-                        PointHelper::pointInConvexPolygon(polygon.getPoints(), *edge.getV())) {
-                        #pragma omp atomic write
-                        edgeIntersectsPolygon = true;
-                    }
-                }
+        hCosts.resize(improved.size());
+        this->evaluateHeuristic(improved.data(), static_cast<int>(improved.size()), idV, useLandmarks, hCosts.data());
+
+        for (std::size_t i = 0; i < improved.size(); i++) {
+            // Vértice que não alcança o destino: com chave infinita ele sairia da fila em
+            // qualquer ordem e seria reexpandido a cada melhora
+            if (std::isfinite(hCosts[i])) {
+                context.push(improved[i], context.getCost(improved[i]) + hCosts[i]);
             }
+        }
+    }
+
+    // Reconstroi o caminho a partir dos predecessores (vazio se não chegou ao destino)
+    return context.extractPath(idU, idV);
+}
+
+std::vector<int> DynamicGraph::searchBidirectionalAStar(const int idU, const int idV, const bool considerPolygons) {
+    if (idU == idV) {
+        return {};
+    }
+
+    // Potencial médio: pF(v) = (h(v, destino) - h(v, origem)) / 2 e pR(v) = -pF(v)
+    // Com os dois potenciais somando zero, ambos são consistentes e o critério de parada
+    // passa a ser topoF + topoR >= melhor caminho encontrado
+    const auto forwardPotential = [&](const int node) {
+        return (this->geometricDistance(node, idV) - this->geometricDistance(node, idU)) / 2.0;
+    };
+
+    SearchContext &forward = getSearchContext(0);
+    SearchContext &backward = getSearchContext(1);
+    const SearchContext::QueueType queue = this->chooseQueue(this->bidirectionalQueue, false);
+    forward.reset(this->road->network.getNumNodes(), queue);
+    backward.reset(this->road->network.getNumNodes(), queue);
+
+    forward.update(idU, 0.0, -1);
+    forward.push(idU, forwardPotential(idU));
+    backward.update(idV, 0.0, -1);
+    backward.push(idV, -forwardPotential(idV));
+
+    double bestCost = std::numeric_limits<double>::infinity();
+    int meetingNode = -1;
+
+    while (!forward.queueEmpty() && !backward.queueEmpty()) {
+        if (forward.topKey() + backward.topKey() >= bestCost) {
+            break;
+        }
 
-            // Essa aresta não pode ser utilizada
-            if (edgeIntersectsPolygon) {
+        // Expande o lado com a menor chave
+        const bool expandForward = forward.topKey() <= backward.topKey();
+        SearchContext &context = expandForward ? forward : backward;
+        const SearchContext &other = expandForward ? backward : forward;
+
+        const int u = context.pop();
+        const double gCost = context.getCost(u);
+        context.markSettled();
+
+        const int begin = expandForward ? this->road->network.beginEdge(u) : this->road->network.beginInEdge(u);
+        const int end = expandForward ? this->road->network.endEdge(u) : this->road->network.endInEdge(u);
+
+        for (int i = begin; i < end; i++) {
+            // A busca reversa percorre as arestas de entrada (índices do CSR de saída)
+            const int e = expandForward ? i : this->road->network.getInEdge(i);
+
+            if (considerPolygons && this->obstacles.isEdgeBlocked(e)) {
                 continue;
             }
 
-            const double newGCost = gCosts[u] + weight;
+            const int v = expandForward ? this->road->network.getEdgeTarget(e) : this->road->network.getEdgeSource(e);
+            const double newGCost = gCost + this->road->network.getEdgeWeight(e);
 
-            if (newGCost < gCosts[v]) {
-                gCosts[v] = newGCost;
-                previous[v] = u;
+            if (newGCost < context.getCost(v)) {
+                context.update(v, newGCost, u);
 
-                const double hCost = PointHelper::haversineDistance(this->idToPoint.at(v), target);
-                const double fCost = newGCost + hCost;
+                const double potential = expandForward ? forwardPotential(v) : -forwardPotential(v);
+                context.push(v, newGCost + potential);
 
-                pq.emplace(v, newGCost, fCost);
+                // Se o outro lado já alcançou v, existe um caminho origem -> v -> destino
+                if (const double total = newGCost + other.getCost(v); total < bestCost) {
+                    bestCost = total;
+                    meetingNode = v;
+                }
             }
         }
     }
 
-    if (!previous.contains(idV) || previous.at(idV) == -1) {
-        return findPathAStar(idU, idV);
+    if (meetingNode == -1) {
+        return {};
     }
 
-    long long current = idV;
-    while (current != idU && previous.at(current) != -1) {
+    // Junta a metade da origem (até o encontro) com a metade do destino
+    std::vector<int> path = forward.extractPath(idU, meetingNode);
+
+    for (int current = meetingNode; current != idV;) {
+        current = backward.getPrevious(current);
         path.push_back(current);
-        current = previous.at(current);
     }
 
-    std::reverse(path.begin(), path.end());
     return path;
 }
+
+std::vector<int> DynamicGraph::searchIgnoringPolygons(const int idU, const int idV, const SearchAlgorithm algorithm) {
+    if (algorithm == BidirectionalAStar) {
+        return this->searchBidirectionalAStar(idU, idV, false);
+    }
+
+    if (algorithm == ContractionHierarchies) {
+        this->prepareContractionHierarchy();
+        return this->road->hierarchy.query(this->road->staticMetric, idU, idV);
+    }
+
+    if (algorithm == AltAStar) {
+        if (!this->road->landmarks.isReady()) this->prepareLandmarks();
+        return this->searchAStar(idU, idV, false, true);
+    }
+
+    return this->searchAStar(idU, idV, false, false);
+}
+
+std::vector<int> DynamicGraph::findPathAStar(const int idU, const int idV, const SearchAlgorithm algorithm) {
+    // A* que retorna o caminho encontrado
+    const int numNodes = this->road->network.getNumNodes();
+    if (idU < 0 || idU >= numNodes || idV < 0 || idV >= numNodes) {
+        return {};
+    }
+
+    // Sem polígonos a resposta não depende da época dos bloqueios
+    std::vector<int> path;
+    if (this->routeCache.lookup(idU, idV, algorithm, false, 0, path)) {
+        return path;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    path = this->searchIgnoringPolygons(idU, idV, algorithm);
+    const auto end = std::chrono::high_resolution_clock::now();
+    this->routeCache.insert(idU, idV, algorithm, false, 0, path, true,
+                            std::chrono::duration<double, std::micro>(end - start).count());
+
+    return path;
+}
+
+std::vector<int> DynamicGraph::findPathAStarConsideringPolygons(const int idU, const int idV, const SearchAlgorithm algorithm) {
+    // Similar ao anterior porem considerando os polígonos
+    const int numNodes = this->road->network.getNumNodes();
+    if (idU < 0 || idU >= numNodes || idV < 0 || idV >= numNodes) {
+        return {};
+    }
+
+    this->refreshObstacleSnapshot();
+
+    // Se o destino está obstruído, retorna sem considerar os polígonos: a resposta é a do agente estático
+    // (mesma consulta sem polígonos) e os sufixos dela valem para os próximos vértices do agente
+    if (this->obstacles.isNodeBlocked(idV)) {
+        return this->findPathAStar(idU, idV, algorithm);
+    }
+
+    std::vector<int> path;
+    if (this->routeCache.lookup(idU, idV, algorithm, true, this->obstacles.getEpoch(), path)) {
+        return path;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    bool avoidsPolygons = true;
+
+    if (algorithm == BidirectionalAStar) {
+        path = this->searchBidirectionalAStar(idU, idV, true);
+    } else if (algorithm == ContractionHierarchies) {
+        this->prepareContractionHierarchy();
+        this->applyPendingCustomization();
+        path = this->road->hierarchy.query(this->dynamicMetric, idU, idV);
+    } else if (algorithm == AltAStar) {
+        if (!this->road->landmarks.isReady()) this->prepareLandmarks();
+        path = this->searchAStar(idU, idV, true, true);
+    } else {
+        path = this->searchAStar(idU, idV, true, false);
+    }
+
+    // Sem caminho que evite os polígonos, retorna sem considerá-los (sem uma segunda consulta à cache)
+    if (path.empty()) {
+        path = this->searchIgnoringPolygons(idU, idV, algorithm);
+        avoidsPolygons = false;
+    }
+
+    // Os sufixos só são reaproveitados quando o caminho realmente evita os polígonos
+    const auto end = std::chrono::high_resolution_clock::now();
+    this->routeCache.insert(idU, idV, algorithm, true, this->obstacles.getEpoch(), path, avoidsPolygons,
+                            std::chrono::duration<double, std::micro>(end - start).count());
+
+    return path;
+}
+
+std::vector<int> DynamicGraph::findPathIncremental(DStarLite &planner, const int idU, const int idV) {
+    // Mesmo comportamento de findPathAStarConsideringPolygons, mas reaproveitando a árvore do planejador
+    const int numNodes = this->road->network.getNumNodes();
+    if (idU < 0 || idU >= numNodes || idV < 0 || idV >= numNodes) {
+        return {};
+    }
+
+    this->refreshObstacleSnapshot();
+
+    if (this->obstacles.isNodeBlocked(idV)) {
+        return findPathAStar(idU, idV);
+    }
+
+    // Uma árvore por destino, reiniciada apenas quando o destino muda
+    if (planner.getGoal() != idV) {
+        planner.reset(this->road->network, this->obstacles, idU, idV);
+    }
+
+    std::vector<int> path = planner.plan(this->obstacles, idU);
+
+    if (path.empty()) {
+        return findPathAStar(idU, idV);
+    }
+
+    return path;
+}
+
+std::vector<std::vector<int>> DynamicGraph::findPaths(const std::vector<std::pair<int, int>> &queries,
+                                                      const bool considerPolygons, const SearchAlgorithm algorithm,
+                                                      const int numThreads) {
+    // Tudo que é preparado sob demanda é feito antes, então as threads apenas leem o grafo
+    this->prepareQueries(algorithm);
+
+    std::vector<std::vector<int>> paths(queries.size());
+    const int threads = numThreads > 0 ? numThreads : omp_get_max_threads();
+
+    // Cada thread usa a própria área de trabalho (getSearchContext) e as consultas têm custos
+    // muito diferentes, então são distribuídas dinamicamente
+    #pragma omp parallel for schedule(dynamic, 16) num_threads(threads)
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        const auto &[u, v] = queries[i];
+        paths[i] = considerPolygons ? this->findPathAStarConsideringPolygons(u, v, algorithm)
+                                    : this->findPathAStar(u, v, algorithm);
+    }
+
+    return paths;
+}
@@ -4,74 +4,165 @@
 
 #ifndef PROJETOCONCLUSAOCURSO_DYNAMIC_GRAPH_H
 #define PROJETOCONCLUSAOCURSO_DYNAMIC_GRAPH_H
-#include <list>
-#include <unordered_map>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "ContractionHierarchy.h"
+#include "DStarLite.h"
+#include "DistanceMatrix.h"
+#include "Landmarks.h"
+#include "ObstacleSnapshot.h"
+#include "RoadNetwork.h"
+#include "RouteCache.h"
+#include "SearchContext.h"
+#include "StaticGraph.h"
 #include "../geometry/Edge.h"
 #include "../geometry/Point.h"
-#include "../geometry/Polygon.h"
+#include "../geometry/FixedPolygon.h"
+#include "../geometry/PolygonBatch.h"
+#include "../geometry/PolygonIndex.h"
 #include "../geometry/UniformGrid.h"
 
 
-class Polygon;
-
 class DynamicGraph {
-    std::unordered_map<long long, Point> idToPoint;     // Mapeia os ids do OpenStreetMap para os pontos criados
-    std::unordered_map<long long, std::list<Edge>> adj; // Lista de adjacência
-    std::vector<Polygon> polygons;                      // Polígonos que modelam os congestionamentos
-    UniformGrid uniformGrid;                            // Grade uniforme
-    double cellSize;                                    // Tamanho da célula
-
-    double minLon;
-    double maxLon;
-    double minLat;
-    double maxLat;
+public:
+    // Algoritmos de busca ponto a ponto (Incremental: D* Lite no agente dinâmico, A* nas demais consultas)
+    enum SearchAlgorithm { AStar, BidirectionalAStar, ContractionHierarchies, AltAStar, Incremental };
+    // Heurística geométrica do A*: haversine exato ou corda (limite inferior sem trigonometria)
+    enum GeometricHeuristic { Haversine, Chord };
+
+private:
+    // Malha e estruturas imutáveis, compartilhadas com as execuções criadas por createTrial
+    // Só podem ser modificadas (leitura, congelamento, preparações) antes de existir alguma execução
+    std::shared_ptr<StaticGraph> road;
+    // Grade das arestas (blocos densos/esparsos) com a resolução do raio dos polígonos, compartilhada pelas
+    // execuções do mesmo raio
+    std::shared_ptr<const UniformGrid> grid = std::make_shared<UniformGrid>();
+    std::vector<Hexagon> polygons;                      // Polígonos que modelam os congestionamentos (contíguos)
+    PolygonBatch polygonBatch;                          // Os mesmos polígonos em estrutura de arrays
+    PolygonIndex polygonIndex;                          // Célula -> polígonos que a ocupam
+    ObstacleSnapshot obstacles;                         // Vértices/arestas bloqueados no tick atual
+    bool obstaclesDirty = true;                         // Se os polígonos mudaram desde a última fotografia
+
+    ContractionHierarchy::Metric dynamicMetric;         // Pesos com as arestas bloqueadas do tick atual
+    bool dynamicMetricReady = false;
+    long long hierarchyBuildUs = 0;                     // Tempo de pré-processamento (ordem + atalhos + customizações)
+    std::vector<int> pendingCustomization;              // Arestas que mudaram de estado desde a última recustomização
+    Bitmap pendingCustomizationBits;
+    long long customizationUs = 0;                      // Tempo acumulado das recustomizações
+    long long customizationCount = 0;
+    long long landmarksBuildUs = 0;                     // Tempo para selecionar/carregar os landmarks
+    SearchContext::QueueType unidirectionalQueue = SearchContext::RadixHeap;        // Heap 4-ário se a heurística não for consistente
+    SearchContext::QueueType bidirectionalQueue = SearchContext::QuaternaryHeap;    // Consulta o topo das duas filas a cada passo
+    GeometricHeuristic geometricHeuristic = Haversine;  // Heurística das buscas sem landmarks (corda com --heuristic)
+    RouteCache routeCache;                              // Caminhos já calculados (por época dos bloqueios)
+    std::uint64_t seed = 0;                             // Semente global (--seed)
+    std::uint32_t trial = 0;                            // Execução atual (sequências distintas por teste)
+    std::uint32_t motionTick = 0;                       // Ticks de movimento dos polígonos desde setRandomSeed
 
     struct DijkstraNode {
-        long long id;
+        int id;
         double distance;
 
-        DijkstraNode(const long long id, const double distance) : id(id), distance(distance) {}
+        DijkstraNode(const int id, const double distance) : id(id), distance(distance) {}
 
         bool operator>(const DijkstraNode& other) const {
             return distance > other.distance;
         }
     };
 
-    struct AStarNode {
-        long long id;
-        double gCost;
-        double fCost;
+    static constexpr double maxGridCells = 1 << 22;     // Limite de células da grade (mapas grandes)
 
-        AStarNode(const long long id, const double gCost, const double fCost) : id(id), gCost(gCost), fCost(fCost) {}
+    double chooseCellSize(double polygonRadius) const;
+    std::shared_ptr<const UniformGrid> buildGrid(double polygonRadius) const;
+    SearchContext::QueueType chooseQueue(SearchContext::QueueType preferred, bool useLandmarks) const;
+    void evaluateHeuristic(const int *nodes, int count, int target, bool useLandmarks, double *out) const;
+    double geometricDistance(int idU, int idV) const;
+    std::vector<int> searchAStar(int idU, int idV, bool considerPolygons, bool useLandmarks);
+    std::vector<int> searchBidirectionalAStar(int idU, int idV, bool considerPolygons);
+    // Busca sem polígonos e sem passar pela cache (as consultas que a usam fazem um único acesso)
+    std::vector<int> searchIgnoringPolygons(int idU, int idV, SearchAlgorithm algorithm);
 
-        bool operator>(const AStarNode& other) const {
-            return fCost > other.fCost;
-        }
-    };
+    DynamicGraph(std::shared_ptr<StaticGraph> road, std::shared_ptr<const UniformGrid> grid);
 
 public:
     DynamicGraph();
 
+    // Execução independente (polígonos, bloqueios, cache e sequências aleatórias próprios) sobre a mesma malha
+    // As preparações compartilhadas (CCH, landmarks) precisam ser feitas antes, no grafo original
+    DynamicGraph createTrial(std::uint32_t newTrial) const;
+    // Grafo sem polígonos sobre a mesma malha (e preparações), com a grade que freeze escolheria para o raio
+    // Reaproveita a grade atual quando a resolução é a mesma
+    DynamicGraph withPolygonRadius(double polygonRadius) const;
+    // Soma as estatísticas de recustomização e da cache de rotas de uma execução às deste grafo
+    void addTrialStatistics(const DynamicGraph &trialGraph);
+
     void addPoint(long long id, double x, double y);
     void addEdge(long long idU, long long idV, double dist);
-    void addPolygon(const Polygon &polygon);
-    void clearPolygons() { this->polygons.clear(); };
-
-    void updatePolygonsPosition();
-    std::vector<long long> findPathAStar(long long idU, long long idV);
-    std::vector<long long> findPathAStarConsideringPolygons(long long idU, long long idV);
-
-    const std::unordered_map<long long, Point> &getIdToPoint() const { return this->idToPoint; }
-    const std::unordered_map<long long, std::list<Edge>> &getAdj() const { return this->adj; }
-    const std::vector<Polygon> &getPolygons() const { return this->polygons; }
-    const UniformGrid &getUniformGrid() const { return this->uniformGrid; }
-    double getCellSize() const { return this->cellSize; }
-    double getMinLon() const { return this->minLon; }
-    double getMaxLon() const { return this->maxLon; }
-    double getMinLat() const { return this->minLat; }
-    double getMaxLat() const { return this->maxLat; }
+    // polygonRadius é o raio típico dos polígonos (0 se desconhecido), usado na resolução da grade
+    void freeze(double polygonRadius = 0.0);
+    void addPolygon(const Hexagon &polygon);
+    void clearPolygons();
+    // A posição e o movimento dos polígonos e a escolha dos agentes dependem apenas da semente e da execução
+    void setRandomSeed(std::uint64_t newSeed, std::uint32_t newTrial = 0);
+    std::uint64_t getSeed() const { return this->seed; }
+    std::uint32_t getTrial() const { return this->trial; }
+
+    // Avança os polígonos ticks ticks de uma vez (mesmas posições de ticks chamadas seguidas), com uma única
+    // fotografia dos bloqueios no final. Usado para pular os ticks em que nenhum agente consulta os bloqueios
+    void updatePolygonsPosition(int ticks = 1);
+    void refreshObstacleSnapshot();
+    void prepareContractionHierarchy();
+    void applyPendingCustomization();
+    bool prepareLandmarks(int count = Landmarks::defaultCount, const std::string &cachePath = "");
+    // Prepara tudo que as buscas do algoritmo fariam sob demanda (fotografia, CCH, landmarks)
+    // Depois disso as buscas apenas leem o grafo e podem rodar em paralelo até a próxima mudança dos polígonos
+    void prepareQueries(SearchAlgorithm algorithm);
+    // Distâncias sem polígonos entre todos os pares de nodes, retorna o tempo em µs
+    // Com useHierarchy usa RPHAST sobre a CCH (pré-processada se preciso), senão um Dijkstra por origem
+    long long computeDistanceMatrix(const std::vector<int> &nodes, DistanceMatrix &matrix, bool useHierarchy = true);
+    bool isNodeBlocked(const int id) const { return this->obstacles.isNodeBlocked(id); }
+    bool isEdgeBlocked(const int edge) const { return this->obstacles.isEdgeBlocked(edge); }
+    // Se o passo u -> v encontra algum bloqueio (extremidades ou a aresta atravessando um polígono)
+    bool isStepBlocked(int u, int v) const;
+    // Se alguma caixa delimitadora ocupa a célula (fotografia do tick; índice espacial fora da grade ou antes dela)
+    bool isCellOccupied(const Cell &cell) const;
+
+    void setGeometricHeuristic(GeometricHeuristic heuristic);
+    void setRouteCacheEnabled(bool enabled);
+    const RouteCache::Stats &getRouteCacheStats() const { return this->routeCache.getStats(); }
+    void setSearchQueues(SearchContext::QueueType unidirectional, SearchContext::QueueType bidirectional);
+    static SearchContext &getSearchContext(int direction = 0);
+    std::vector<int> findPathAStar(int idU, int idV, SearchAlgorithm algorithm = AStar);
+    std::vector<int> findPathAStarConsideringPolygons(int idU, int idV, SearchAlgorithm algorithm = AStar);
+    std::vector<int> findPathIncremental(DStarLite &planner, int idU, int idV);
+    // Várias consultas (origem, destino) em paralelo sobre a fotografia atual dos bloqueios
+    // numThreads <= 0 usa todas as threads do OpenMP
+    std::vector<std::vector<int>> findPaths(const std::vector<std::pair<int, int>> &queries, bool considerPolygons,
+                                            SearchAlgorithm algorithm = AStar, int numThreads = 0);
+
+    const RoadNetwork &getNetwork() const { return this->road->network; }
+    Point getPoint(const int id) const { return this->road->network.getPoint(id); }
+    const std::vector<Hexagon> &getPolygons() const { return this->polygons; }
+    const PolygonBatch &getPolygonBatch() const { return this->polygonBatch; }
+    const PolygonIndex &getPolygonIndex() const { return this->polygonIndex; }
+    const ObstacleSnapshot &getObstacleSnapshot() const { return this->obstacles; }
+    const ContractionHierarchy &getContractionHierarchy() const { return this->road->hierarchy; }
+    long long getHierarchyBuildUs() const { return this->hierarchyBuildUs; }
+    const Landmarks &getLandmarks() const { return this->road->landmarks; }
+    long long getLandmarksBuildUs() const { return this->landmarksBuildUs; }
+    double getAverageCustomizationUs() const {
+        return this->customizationCount == 0 ? 0.0 : static_cast<double>(this->customizationUs) / this->customizationCount;
+    }
+    const UniformGrid &getUniformGrid() const { return *this->grid; }
+    double getCellSize() const { return this->grid->getCellSize(); }
+    double getMinLon() const { return this->road->minLon; }
+    double getMaxLon() const { return this->road->maxLon; }
+    double getMinLat() const { return this->road->minLat; }
+    double getMaxLat() const { return this->road->maxLat; }
 };
 
 
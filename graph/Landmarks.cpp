@@ -0,0 +1,182 @@
+#include "Landmarks.h"
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <queue>
+
+void Landmarks::dijkstra(const RoadNetwork &network, const int source, const bool reverse, std::vector<double> &distances) {
+    using QueueNode = std::pair<double, int>;
+
+    distances.assign(network.getNumNodes(), std::numeric_limits<double>::infinity());
+    std::priority_queue<QueueNode, std::vector<QueueNode>, std::greater<>> queue;
+
+    distances[source] = 0.0;
+    queue.emplace(0.0, source);
+
+    while (!queue.empty()) {
+        const auto [distance, u] = queue.top();
+        queue.pop();
+
+        if (distance > distances[u]) continue;
+
+        // A busca reversa percorre as arestas de entrada, obtendo d(v, source)
+        const int begin = reverse ? network.beginInEdge(u) : network.beginEdge(u);
+        const int end = reverse ? network.endInEdge(u) : network.endEdge(u);
+
+        for (int i = begin; i < end; i++) {
+            const int e = reverse ? network.getInEdge(i) : i;
+            const int v = reverse ? network.getEdgeSource(e) : network.getEdgeTarget(e);
+            const double newDistance = distance + network.getEdgeWeight(e);
+
+            if (newDistance < distances[v]) {
+                distances[v] = newDistance;
+                queue.emplace(newDistance, v);
+            }
+        }
+    }
+}
+
+void Landmarks::select(const RoadNetwork &network, const int count) {
+    this->numNodes = network.getNumNodes();
+    this->numEdges = network.getNumEdges();
+    this->networkFingerprint = network.getFingerprint();
+    this->landmarks.clear();
+
+    const int k = std::min(count, this->numNodes);
+    if (k <= 0) return;
+
+    std::vector<std::vector<double>> forward(k);
+    std::vector<double> minDistance(this->numNodes, std::numeric_limits<double>::infinity());
+
+    // O primeiro landmark é o vértice mais distante de um vértice qualquer
+    std::vector<double> distances;
+    dijkstra(network, 0, false, distances);
+
+    for (int i = 0; i < k; i++) {
+        // Escolhe o vértice alcançável que está mais longe do landmark mais próximo
+        const std::vector<double> &reference = i == 0 ? distances : minDistance;
+        int farthest = -1;
+        for (int v = 0; v < this->numNodes; v++) {
+            if (!std::isfinite(reference[v])) continue;
+            if (farthest == -1 || reference[v] > reference[farthest]) farthest = v;
+        }
+
+        // Sem vértices alcançáveis novos (malha menor que a quantidade pedida)
+        if (farthest == -1 || (i > 0 && reference[farthest] == 0.0)) break;
+
+        this->landmarks.push_back(farthest);
+        dijkstra(network, farthest, false, forward[i]);
+
+        for (int v = 0; v < this->numNodes; v++) {
+            minDistance[v] = std::min(minDistance[v], forward[i][v]);
+        }
+    }
+
+    // As distâncias até cada landmark são independentes entre si
+    const int numLandmarks = this->getNumLandmarks();
+    std::vector<std::vector<double>> backward(numLandmarks);
+
+    #pragma omp parallel for
+    for (int l = 0; l < numLandmarks; l++) {
+        dijkstra(network, this->landmarks[l], true, backward[l]);
+    }
+
+    this->fromLandmark.resize(static_cast<std::size_t>(this->numNodes) * numLandmarks);
+    this->toLandmark.resize(static_cast<std::size_t>(this->numNodes) * numLandmarks);
+
+    for (int v = 0; v < this->numNodes; v++) {
+        for (int l = 0; l < numLandmarks; l++) {
+            this->fromLandmark[static_cast<std::size_t>(v) * numLandmarks + l] = forward[l][v];
+            this->toLandmark[static_cast<std::size_t>(v) * numLandmarks + l] = backward[l][v];
+        }
+    }
+}
+
+bool Landmarks::save(const std::string &path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open() || !this->isReady()) {
+        return false;
+    }
+
+    // Cabeçalho com o resumo e o tamanho da malha para reconhecer tabelas de outro arquivo de entrada
+    const std::int32_t header[] = {this->numNodes, this->numEdges, this->getNumLandmarks()};
+    file.write(reinterpret_cast<const char *>(&this->networkFingerprint), sizeof(this->networkFingerprint));
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(this->landmarks.data()), this->landmarks.size() * sizeof(int));
+    file.write(reinterpret_cast<const char *>(this->fromLandmark.data()), this->fromLandmark.size() * sizeof(double));
+    file.write(reinterpret_cast<const char *>(this->toLandmark.data()), this->toLandmark.size() * sizeof(double));
+
+    return file.good();
+}
+
+bool Landmarks::load(const std::string &path, const RoadNetwork &network) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::uint64_t fingerprint;
+    std::int32_t header[3];
+    file.read(reinterpret_cast<char *>(&fingerprint), sizeof(fingerprint));
+    file.read(reinterpret_cast<char *>(header), sizeof(header));
+    if (!file || fingerprint != network.getFingerprint() || header[0] != network.getNumNodes() || header[1] != network.getNumEdges() || header[2] <= 0) {
+        return false;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(header[0]) * header[2];
+    std::vector<int> newLandmarks(header[2]);
+    std::vector<double> newFrom(size);
+    std::vector<double> newTo(size);
+
+    file.read(reinterpret_cast<char *>(newLandmarks.data()), newLandmarks.size() * sizeof(int));
+    file.read(reinterpret_cast<char *>(newFrom.data()), size * sizeof(double));
+    file.read(reinterpret_cast<char *>(newTo.data()), size * sizeof(double));
+    if (!file) {
+        return false;
+    }
+
+    this->numNodes = header[0];
+    this->numEdges = header[1];
+    this->networkFingerprint = fingerprint;
+    this->landmarks = std::move(newLandmarks);
+    this->fromLandmark = std::move(newFrom);
+    this->toLandmark = std::move(newTo);
+
+    return true;
+}
+
+double Landmarks::lowerBound(const int node, const int target) const {
+    const int k = this->getNumLandmarks();
+    const double *fromNode = &this->fromLandmark[static_cast<std::size_t>(node) * k];
+    const double *fromTarget = &this->fromLandmark[static_cast<std::size_t>(target) * k];
+    const double *toNode = &this->toLandmark[static_cast<std::size_t>(node) * k];
+    const double *toTarget = &this->toLandmark[static_cast<std::size_t>(target) * k];
+
+    double bound = 0.0;
+    for (int l = 0; l < k; l++) {
+        // d(L, t) - d(L, v) <= d(v, t) e d(v, L) - d(t, L) <= d(v, t)
+        // L alcança v mas não t, ou t alcança L mas v não: v não alcança t. O limite infinito (e não ignorar o
+        // landmark) mantém a heurística consistente, já que todo sucessor de v também não alcança t
+        if (std::isfinite(fromNode[l])) {
+            if (!std::isfinite(fromTarget[l])) {
+                return std::numeric_limits<double>::infinity();
+            }
+            bound = std::max(bound, fromTarget[l] - fromNode[l]);
+        }
+        if (std::isfinite(toTarget[l])) {
+            if (!std::isfinite(toNode[l])) {
+                return std::numeric_limits<double>::infinity();
+            }
+            bound = std::max(bound, toNode[l] - toTarget[l]);
+        }
+    }
+
+    return bound;
+}
+
+std::size_t Landmarks::memoryUsage() const {
+    return this->landmarks.capacity() * sizeof(int) +
+           (this->fromLandmark.capacity() + this->toLandmark.capacity()) * sizeof(double);
+}
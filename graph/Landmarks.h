@@ -0,0 +1,44 @@
+#ifndef PROJETOCONCLUSAOCURSO_LANDMARKS_H
+#define PROJETOCONCLUSAOCURSO_LANDMARKS_H
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RoadNetwork.h"
+
+
+// Heurística ALT (A*, Landmarks e desigualdade triangular)
+// Para cada landmark L guarda d(L, v) e d(v, L) de todos os vértices, então
+// d(v, t) >= max(d(L, t) - d(L, v), d(v, L) - d(t, L)) é um limite inferior exato da malha.
+// Bloquear arestas só aumenta as distâncias, logo o limite continua válido com os polígonos
+class Landmarks {
+    int numNodes = 0;
+    int numEdges = 0;
+    std::uint64_t networkFingerprint = 0;       // RoadNetwork::getFingerprint da malha das tabelas
+    std::vector<int> landmarks;                 // Vértices escolhidos como landmarks
+    std::vector<double> fromLandmark;           // d(L, v) em [v * k + l] (landmarks de um vértice contíguos)
+    std::vector<double> toLandmark;             // d(v, L) em [v * k + l]
+
+public:
+    // Distâncias de source para todos os vértices (ou de todos para source, com reverse)
+    static void dijkstra(const RoadNetwork &network, int source, bool reverse, std::vector<double> &distances);
+
+    static constexpr int defaultCount = 16;
+
+    // Seleção por ponto mais distante: cada novo landmark é o vértice mais longe dos já escolhidos
+    void select(const RoadNetwork &network, int count);
+
+    // Tabelas em disco (formato binário), falso se o arquivo não existir ou for de outra malha
+    bool save(const std::string &path) const;
+    bool load(const std::string &path, const RoadNetwork &network);
+
+    bool isReady() const { return !this->landmarks.empty(); }
+    int getNumLandmarks() const { return static_cast<int>(this->landmarks.size()); }
+    int getLandmark(const int i) const { return this->landmarks[i]; }
+
+    double lowerBound(int node, int target) const;
+    std::size_t memoryUsage() const;
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_LANDMARKS_H
@@ -0,0 +1,152 @@
+#include "ObstacleSnapshot.h"
+
+
+std::uint64_t ObstacleSnapshot::mixEdge(const int edge) {
+    // Finalizador do splitmix64: ids próximos viram valores sem relação
+    std::uint64_t z = static_cast<std::uint64_t>(edge) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void ObstacleSnapshot::rebuild(const RoadNetwork &network, const UniformGrid &grid, const PolygonBatch &batch,
+                               const PolygonIndex &index) {
+    if (this->blockedNodeBits.size() != network.getNumNodes()) {
+        this->blockedNodeBits.resize(network.getNumNodes());
+        this->blockedEdgeBits.resize(network.getNumEdges());
+        this->previousEdgeBits.resize(network.getNumEdges());
+        this->blockedNodes.clear();
+        this->blockedEdges.clear();
+        this->previousBlockedEdges.clear();
+    }
+
+    if (this->occupiedCellBits.size() != grid.getNumCells()) {
+        this->occupiedCellBits.resize(grid.getNumCells());
+        this->occupiedCells.clear();
+    }
+
+    // Limpa apenas os bits ligados nos ticks anteriores
+    // As arestas do tick anterior são mantidas para calcular a diferença com o tick atual
+    for (const int node : this->blockedNodes) this->blockedNodeBits.reset(node);
+    for (const int edge : this->previousBlockedEdges) this->previousEdgeBits.reset(edge);
+    this->blockedNodes.clear();
+    for (const int cell : this->occupiedCells) this->occupiedCellBits.reset(cell);
+    this->occupiedCells.clear();
+
+    std::swap(this->blockedEdgeBits, this->previousEdgeBits);
+    std::swap(this->blockedEdges, this->previousBlockedEdges);
+    this->blockedEdges.clear();
+    this->changedEdges.clear();
+    this->candidateTests = 0;
+    this->candidateEdges = 0;
+    this->segmentTests = 0;
+
+    // Todo vértice dentro de um polígono está em uma célula da caixa delimitadora dele (mantida pelo índice)
+    // e a grade guarda, em cada célula, as arestas incidentes aos vértices daquela célula
+    for (int p = 0; p < batch.size(); p++) {
+        this->candidateNodes.clear();
+        this->candidateX.clear();
+        this->candidateY.clear();
+
+        const PolygonIndex::CellRange &range = index.getRange(p);
+
+        // Ocupação das células, uma vez por tick para todos os agentes
+        for (int i = range.iMin; i <= range.iMax; i++) {
+            for (int j = range.jMin; j <= range.jMax; j++) {
+                const int cell = grid.getCellIndex(Cell(i, j));
+                if (cell >= 0 && !this->occupiedCellBits.test(cell)) {
+                    this->occupiedCellBits.set(cell);
+                    this->occupiedCells.push_back(cell);
+                }
+            }
+        }
+
+        grid.collectLists(range.iMin, range.iMax, range.jMin, range.jMax, this->candidateLists);
+
+        for (const int list : this->candidateLists) {
+            this->candidateEdges += grid.endList(list) - grid.beginList(list);
+
+            for (int pos = grid.beginList(list); pos < grid.endList(list); pos++) {
+                const int edge = grid.getListEdge(pos);
+                for (const int node : {network.getEdgeSource(edge), network.getEdgeTarget(edge)}) {
+                    if (this->blockedNodeBits.test(node)) continue;
+
+                    this->candidateNodes.push_back(node);
+                    this->candidateX.push_back(network.getX(node));
+                    this->candidateY.push_back(network.getY(node));
+                }
+            }
+        }
+
+        const int count = static_cast<int>(this->candidateNodes.size());
+        this->candidateTests += count;
+        this->candidateInside.resize(count);
+        batch.containsPoints(p, this->candidateX.data(), this->candidateY.data(), count, this->candidateInside.data());
+
+        // O mesmo vértice pode aparecer mais de uma vez (uma por aresta incidente)
+        for (int i = 0; i < count; i++) {
+            const int node = this->candidateNodes[i];
+            if (this->candidateInside[i] && !this->blockedNodeBits.test(node)) {
+                this->blockedNodeBits.set(node);
+                this->blockedNodes.push_back(node);
+            }
+        }
+    }
+
+    // Uma aresta é bloqueada quando alguma das suas extremidades está bloqueada
+    for (const int node : this->blockedNodes) {
+        for (int e = network.beginEdge(node); e < network.endEdge(node); e++) {
+            if (!this->blockedEdgeBits.test(e)) {
+                this->blockedEdgeBits.set(e);
+                this->blockedEdges.push_back(e);
+            }
+        }
+
+        for (int i = network.beginInEdge(node); i < network.endInEdge(node); i++) {
+            const int e = network.getInEdge(i);
+            if (!this->blockedEdgeBits.test(e)) {
+                this->blockedEdgeBits.set(e);
+                this->blockedEdges.push_back(e);
+            }
+        }
+    }
+
+    // Arestas longas podem atravessar um polígono sem nenhuma extremidade dentro dele
+    // A grade guarda as arestas nas células que elas atravessam, então basta olhar as células do polígono
+    for (int p = 0; p < batch.size(); p++) {
+        const PolygonIndex::CellRange &range = index.getRange(p);
+        grid.collectLists(range.iMin, range.iMax, range.jMin, range.jMax, this->candidateLists);
+
+        for (const int list : this->candidateLists) {
+            for (int pos = grid.beginList(list); pos < grid.endList(list); pos++) {
+                const int edge = grid.getListEdge(pos);
+                if (this->blockedEdgeBits.test(edge)) continue;
+
+                const int u = network.getEdgeSource(edge);
+                const int v = network.getEdgeTarget(edge);
+
+                this->segmentTests++;
+                if (batch.intersectsSegment(p, network.getX(u), network.getY(u), network.getX(v), network.getY(v))) {
+                    this->blockedEdgeBits.set(edge);
+                    this->blockedEdges.push_back(edge);
+                }
+            }
+        }
+    }
+
+    // Diferença simétrica com a fotografia anterior
+    for (const int edge : this->previousBlockedEdges) {
+        if (!this->blockedEdgeBits.test(edge)) this->changedEdges.push_back(edge);
+    }
+
+    for (const int edge : this->blockedEdges) {
+        if (!this->previousEdgeBits.test(edge)) this->changedEdges.push_back(edge);
+    }
+
+    // Assinatura do conjunto (soma independente da ordem), recalculada só quando ele muda
+    if (!this->changedEdges.empty()) {
+        std::uint64_t signature = 0;
+        for (const int edge : this->blockedEdges) signature += mixEdge(edge);
+        this->epoch = static_cast<long long>(signature >> 1);
+    }
+}
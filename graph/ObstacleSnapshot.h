@@ -0,0 +1,65 @@
+#ifndef PROJETOCONCLUSAOCURSO_OBSTACLE_SNAPSHOT_H
+#define PROJETOCONCLUSAOCURSO_OBSTACLE_SNAPSHOT_H
+#include <cstdint>
+#include <vector>
+
+#include "RoadNetwork.h"
+#include "../geometry/PolygonBatch.h"
+#include "../geometry/PolygonIndex.h"
+#include "../geometry/UniformGrid.h"
+#include "../helper/Bitmap.h"
+
+
+// Fotografia dos bloqueios de um tick: vértices dentro de algum polígono, arestas que tocam esses vértices
+// e arestas que atravessam algum polígono (mesmo com as duas extremidades livres)
+// É recalculada uma única vez após a movimentação dos polígonos e consultada em O(1) pelas buscas e agentes
+// Guarda também as células da grade ocupadas por alguma caixa delimitadora (índice denso da grade)
+class ObstacleSnapshot {
+    Bitmap blockedNodeBits;
+    Bitmap blockedEdgeBits;
+    Bitmap previousEdgeBits;            // Arestas bloqueadas na fotografia anterior
+    std::vector<int> blockedNodes;      // Lista dos bits ligados (permite limpar sem percorrer o grafo)
+    std::vector<int> blockedEdges;
+    std::vector<int> previousBlockedEdges;
+    std::vector<int> changedEdges;      // Arestas que mudaram de estado em relação à fotografia anterior
+    Bitmap occupiedCellBits;            // Células ocupadas por algum polígono (fora da matriz de blocos não entram)
+    std::vector<int> occupiedCells;
+
+    std::vector<int> candidateLists;    // Listas da grade que cobrem as células de um polígono
+
+    // Vértices candidatos de um polígono em estrutura de arrays (testados de uma vez pelo kernel em lote)
+    std::vector<int> candidateNodes;
+    std::vector<double> candidateX;
+    std::vector<double> candidateY;
+    std::vector<std::uint8_t> candidateInside;
+
+    long long candidateTests = 0;       // Testes ponto-polígono feitos na última reconstrução
+    long long candidateEdges = 0;       // Arestas lidas das células dos polígonos na última reconstrução
+    long long segmentTests = 0;         // Testes segmento-polígono feitos na última reconstrução
+    long long epoch = 0;                // Identifica o conjunto de arestas bloqueadas (muda apenas quando ele muda)
+
+    static std::uint64_t mixEdge(int edge);
+
+public:
+    // batch e index descrevem os mesmos polígonos (na mesma ordem)
+    void rebuild(const RoadNetwork &network, const UniformGrid &grid, const PolygonBatch &batch, const PolygonIndex &index);
+
+    bool isNodeBlocked(const int node) const { return this->blockedNodeBits.test(node); }
+    bool isEdgeBlocked(const int edge) const { return this->blockedEdgeBits.test(edge); }
+    // cellIndex é o índice denso de UniformGrid::getCellIndex
+    bool isCellOccupied(const int cellIndex) const { return this->occupiedCellBits.test(cellIndex); }
+
+    const std::vector<int> &getBlockedNodes() const { return this->blockedNodes; }
+    const std::vector<int> &getBlockedEdges() const { return this->blockedEdges; }
+    const std::vector<int> &getChangedEdges() const { return this->changedEdges; }
+    const std::vector<int> &getOccupiedCells() const { return this->occupiedCells; }
+    long long getCandidateTests() const { return this->candidateTests; }
+    long long getCandidateEdges() const { return this->candidateEdges; }
+    long long getSegmentTests() const { return this->segmentTests; }
+    // Depende apenas do conjunto atual (e não de quantas fotografias foram feitas), então pular fotografias em
+    // ticks sem consultas não muda a época vista pelas consultas seguintes
+    long long getEpoch() const { return this->epoch; }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_OBSTACLE_SNAPSHOT_H
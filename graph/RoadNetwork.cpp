@@ -0,0 +1,211 @@
+#include "RoadNetwork.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "../helper/PointHelper.h"
+
+int RoadNetwork::addNode(const long long osmId, const double x, const double y) {
+    // Depois de congelada a malha não aceita novos vértices
+    if (this->frozen) {
+        return -1;
+    }
+
+    // Se o id já existe apenas atualiza as coordenadas
+    if (const auto it = this->osmToNode.find(osmId); it != this->osmToNode.end()) {
+        this->nodeX[it->second] = x;
+        this->nodeY[it->second] = y;
+        return it->second;
+    }
+
+    const int node = static_cast<int>(this->nodeToOsm.size());
+    this->osmToNode.emplace(osmId, node);
+    this->nodeToOsm.push_back(osmId);
+    this->nodeX.push_back(x);
+    this->nodeY.push_back(y);
+
+    return node;
+}
+
+bool RoadNetwork::addEdge(const long long osmU, const long long osmV, const double dist) {
+    if (this->frozen) {
+        return false;
+    }
+
+    const int u = this->getNode(osmU);
+    const int v = this->getNode(osmV);
+
+    // Arestas com vértices desconhecidos são descartadas
+    if (u == -1 || v == -1) {
+        return false;
+    }
+
+    this->pendingEdges.push_back({u, v, dist});
+    return true;
+}
+
+void RoadNetwork::freeze() {
+    if (this->frozen) return;
+
+    const int numNodes = this->getNumNodes();
+    const int numEdges = static_cast<int>(this->pendingEdges.size());
+
+    // Conta o grau de saída de cada vértice e acumula os offsets
+    this->firstOut.assign(numNodes + 1, 0);
+    for (const auto &edge : this->pendingEdges) {
+        this->firstOut[edge.u + 1]++;
+    }
+
+    for (int i = 0; i < numNodes; i++) {
+        this->firstOut[i + 1] += this->firstOut[i];
+    }
+
+    // Distribui as arestas mantendo a ordem de leitura dentro de cada vértice
+    this->edgeSource.resize(numEdges);
+    this->edgeTarget.resize(numEdges);
+    this->edgeWeight.resize(numEdges);
+
+    std::vector<int> next(this->firstOut.begin(), this->firstOut.end() - 1);
+    for (const auto &edge : this->pendingEdges) {
+        const int pos = next[edge.u]++;
+        this->edgeSource[pos] = edge.u;
+        this->edgeTarget[pos] = edge.v;
+        this->edgeWeight[pos] = edge.dist;
+    }
+
+    // CSR reverso: para cada vértice, as arestas que chegam nele
+    this->firstIn.assign(numNodes + 1, 0);
+    for (int e = 0; e < numEdges; e++) {
+        this->firstIn[this->edgeTarget[e] + 1]++;
+    }
+
+    for (int i = 0; i < numNodes; i++) {
+        this->firstIn[i + 1] += this->firstIn[i];
+    }
+
+    this->inEdge.resize(numEdges);
+    next.assign(this->firstIn.begin(), this->firstIn.end() - 1);
+    for (int e = 0; e < numEdges; e++) {
+        this->inEdge[next[this->edgeTarget[e]]++] = e;
+    }
+
+    // Conversões e senos/cossenos feitos uma única vez por vértice
+    this->nodeLat.resize(numNodes);
+    this->nodeLon.resize(numNodes);
+    this->nodeCosLat.resize(numNodes);
+    this->nodeUnitX.resize(numNodes);
+    this->nodeUnitY.resize(numNodes);
+    this->nodeUnitZ.resize(numNodes);
+
+    for (int i = 0; i < numNodes; i++) {
+        this->nodeLat[i] = this->nodeY[i] * M_PI / 180.0;
+        this->nodeLon[i] = this->nodeX[i] * M_PI / 180.0;
+        this->nodeCosLat[i] = std::cos(this->nodeLat[i]);
+        this->nodeUnitX[i] = this->nodeCosLat[i] * std::cos(this->nodeLon[i]);
+        this->nodeUnitY[i] = this->nodeCosLat[i] * std::sin(this->nodeLon[i]);
+        this->nodeUnitZ[i] = std::sin(this->nodeLat[i]);
+    }
+
+    // A corda nunca passa da haversine, então basta comparar os pesos com a haversine
+    this->geometricWeights = true;
+    for (int e = 0; e < numEdges && this->geometricWeights; e++) {
+        const double distance = this->haversineDistance(this->edgeSource[e], this->edgeTarget[e]);
+        this->geometricWeights = this->edgeWeight[e] >= distance * (1.0 - 1e-9);
+    }
+
+    this->pendingEdges.clear();
+    this->pendingEdges.shrink_to_fit();
+    this->frozen = true;
+}
+
+double RoadNetwork::haversineDistance(const int u, const int v) const {
+    return PointHelper::haversineRadians(this->nodeLat[u], this->nodeLon[u], this->nodeCosLat[u],
+                                         this->nodeLat[v], this->nodeLon[v], this->nodeCosLat[v]);
+}
+
+double RoadNetwork::chordDistance(const int u, const int v) const {
+    return PointHelper::chordDistance(this->nodeUnitX[u], this->nodeUnitY[u], this->nodeUnitZ[u],
+                                      this->nodeUnitX[v], this->nodeUnitY[v], this->nodeUnitZ[v]);
+}
+
+void RoadNetwork::haversineDistances(const int *nodes, const int count, const int target, double *out) const {
+    for (int i = 0; i < count; i++) {
+        out[i] = this->haversineDistance(nodes[i], target);
+    }
+}
+
+void RoadNetwork::chordDistances(const int *nodes, const int count, const int target, double *out) const {
+    const double tx = this->nodeUnitX[target];
+    const double ty = this->nodeUnitY[target];
+    const double tz = this->nodeUnitZ[target];
+
+    // Só aritmética e raiz quadrada: o laço é vetorizado (vários vizinhos por instrução)
+    #pragma omp simd
+    for (int i = 0; i < count; i++) {
+        const int node = nodes[i];
+        out[i] = PointHelper::chordDistance(this->nodeUnitX[node], this->nodeUnitY[node], this->nodeUnitZ[node], tx, ty, tz);
+    }
+}
+
+int RoadNetwork::getNode(const long long osmId) const {
+    const auto it = this->osmToNode.find(osmId);
+    return it == this->osmToNode.end() ? -1 : it->second;
+}
+
+int RoadNetwork::findEdge(const int u, const int v) const {
+    int best = -1;
+
+    for (int e = this->beginEdge(u); e < this->endEdge(u); e++) {
+        if (this->edgeTarget[e] == v && (best == -1 || this->edgeWeight[e] < this->edgeWeight[best])) {
+            best = e;
+        }
+    }
+
+    return best;
+}
+
+std::size_t RoadNetwork::memoryUsage() const {
+    std::size_t bytes = 0;
+
+    bytes += this->nodeX.capacity() * sizeof(double);
+    bytes += this->nodeY.capacity() * sizeof(double);
+    bytes += (this->nodeLat.capacity() + this->nodeLon.capacity() + this->nodeCosLat.capacity()) * sizeof(double);
+    bytes += (this->nodeUnitX.capacity() + this->nodeUnitY.capacity() + this->nodeUnitZ.capacity()) * sizeof(double);
+    bytes += this->nodeToOsm.capacity() * sizeof(long long);
+    bytes += this->firstOut.capacity() * sizeof(int);
+    bytes += this->edgeSource.capacity() * sizeof(int);
+    bytes += this->edgeTarget.capacity() * sizeof(int);
+    bytes += this->edgeWeight.capacity() * sizeof(double);
+    bytes += this->firstIn.capacity() * sizeof(int);
+    bytes += this->inEdge.capacity() * sizeof(int);
+
+    // Tabela de ids do OpenStreetMap (nó com chave, valor, hash e ponteiro + buckets)
+    bytes += this->osmToNode.size() * (sizeof(long long) + sizeof(int) + 2 * sizeof(void*));
+    bytes += this->osmToNode.bucket_count() * sizeof(void*);
+
+    return bytes;
+}
+
+std::uint64_t RoadNetwork::getFingerprint() const {
+    // FNV-1a de 64 bits sobre os ids, o CSR de saída e os pesos (duas malhas com o mesmo tamanho diferem aqui)
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    const auto mix = [&hash](const std::uint64_t value) {
+        for (int byte = 0; byte < 8; byte++) {
+            hash ^= (value >> (byte * 8)) & 0xFF;
+            hash *= 0x100000001B3ULL;
+        }
+    };
+
+    mix(this->getNumNodes());
+    mix(this->getNumEdges());
+    for (const long long osmId : this->nodeToOsm) mix(static_cast<std::uint64_t>(osmId));
+    for (const int first : this->firstOut) mix(static_cast<std::uint64_t>(first));
+    for (const int target : this->edgeTarget) mix(static_cast<std::uint64_t>(target));
+    for (const double weight : this->edgeWeight) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &weight, sizeof(bits));
+        mix(bits);
+    }
+
+    return hash;
+}
@@ -0,0 +1,100 @@
+#ifndef PROJETOCONCLUSAOCURSO_ROAD_NETWORK_H
+#define PROJETOCONCLUSAOCURSO_ROAD_NETWORK_H
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../geometry/Edge.h"
+#include "../geometry/Point.h"
+
+
+// Malha viária congelada em formato CSR (compressed sparse row)
+// Os vértices recebem índices densos de 32 bits e os ids do OpenStreetMap
+// ficam restritos à leitura do arquivo e à saída dos resultados
+class RoadNetwork {
+    struct PendingEdge {
+        int u;
+        int v;
+        double dist;
+    };
+
+    std::unordered_map<long long, int> osmToNode;   // Id do OpenStreetMap -> índice denso
+    std::vector<long long> nodeToOsm;               // Índice denso -> id do OpenStreetMap
+    std::vector<double> nodeX;                      // Longitude de cada vértice
+    std::vector<double> nodeY;                      // Latitude de cada vértice
+
+    // Termos trigonométricos de cada vértice, calculados no congelamento para as heurísticas
+    std::vector<double> nodeLat;                    // Latitude em radianos
+    std::vector<double> nodeLon;                    // Longitude em radianos
+    std::vector<double> nodeCosLat;                 // cos(latitude)
+    std::vector<double> nodeUnitX;                  // Vetor unitário na esfera
+    std::vector<double> nodeUnitY;
+    std::vector<double> nodeUnitZ;
+
+    std::vector<PendingEdge> pendingEdges;          // Arestas lidas antes do congelamento
+
+    std::vector<int> firstOut;                      // Início das arestas de saída de cada vértice (tamanho V + 1)
+    std::vector<int> edgeSource;                    // Origem de cada aresta
+    std::vector<int> edgeTarget;                    // Destino de cada aresta
+    std::vector<double> edgeWeight;                 // Distância em metros de cada aresta
+
+    std::vector<int> firstIn;                       // Início das arestas de entrada de cada vértice (tamanho V + 1)
+    std::vector<int> inEdge;                        // Índice (no CSR de saída) de cada aresta de entrada
+
+    bool frozen = false;
+    bool geometricWeights = false;                  // Nenhum peso é menor que a haversine entre as extremidades
+
+public:
+    RoadNetwork() = default;
+
+    int addNode(long long osmId, double x, double y);
+    bool addEdge(long long osmU, long long osmV, double dist);
+    void freeze();
+
+    bool isFrozen() const { return this->frozen; }
+    int getNumNodes() const { return static_cast<int>(this->nodeToOsm.size()); }
+    int getNumEdges() const { return static_cast<int>(this->edgeTarget.size()); }
+    // Resumo da malha congelada (ids, CSR e pesos) gravado nos arquivos derivados dela (matriz, landmarks)
+    std::uint64_t getFingerprint() const;
+
+    // Retorna -1 caso o id não exista
+    int getNode(long long osmId) const;
+    long long getOsmId(const int node) const { return this->nodeToOsm[node]; }
+
+    double getX(const int node) const { return this->nodeX[node]; }
+    double getY(const int node) const { return this->nodeY[node]; }
+    Point getPoint(const int node) const { return {node, this->nodeX[node], this->nodeY[node]}; }
+
+    // Distância de haversine entre dois vértices (mesmo valor de PointHelper::haversineDistance)
+    double haversineDistance(int u, int v) const;
+    // Limite inferior da distância pela corda (sem funções trigonométricas)
+    double chordDistance(int u, int v) const;
+    // Com os pesos ao menos a distância geométrica, haversine e corda são heurísticas consistentes
+    bool hasGeometricWeights() const { return this->geometricWeights; }
+    // Kernels em lote: distância de cada vértice de nodes até target, escrita em out
+    void haversineDistances(const int *nodes, int count, int target, double *out) const;
+    void chordDistances(const int *nodes, int count, int target, double *out) const;
+
+    // Intervalo [beginEdge, endEdge) das arestas de saída do vértice
+    int beginEdge(const int node) const { return this->firstOut[node]; }
+    int endEdge(const int node) const { return this->firstOut[node + 1]; }
+
+    // Intervalo [beginInEdge, endInEdge) das arestas de entrada do vértice
+    int beginInEdge(const int node) const { return this->firstIn[node]; }
+    int endInEdge(const int node) const { return this->firstIn[node + 1]; }
+    int getInEdge(const int pos) const { return this->inEdge[pos]; }
+
+    int getEdgeSource(const int edge) const { return this->edgeSource[edge]; }
+    int getEdgeTarget(const int edge) const { return this->edgeTarget[edge]; }
+    double getEdgeWeight(const int edge) const { return this->edgeWeight[edge]; }
+    Edge getEdge(const int edge) const { return {this->edgeSource[edge], this->edgeTarget[edge], this->edgeWeight[edge]}; }
+
+    // Aresta mais leve de u para v (-1 se não existir)
+    int findEdge(int u, int v) const;
+
+    // Memória ocupada pelas estruturas congeladas (em bytes)
+    std::size_t memoryUsage() const;
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_ROAD_NETWORK_H
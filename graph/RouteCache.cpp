@@ -0,0 +1,79 @@
+#include "RouteCache.h"
+
+RouteCache::Store &RouteCache::getStore(const bool considerPolygons, const long long currentEpoch) {
+    // Os bloqueios mudaram: nenhum caminho com polígonos guardado continua válido
+    if (considerPolygons && currentEpoch != this->epoch) {
+        this->stores[1].clear();
+        this->epoch = currentEpoch;
+    }
+
+    return this->stores[considerPolygons ? 1 : 0];
+}
+
+bool RouteCache::lookup(const int source, const int target, const int algorithm, const bool considerPolygons,
+                        const long long currentEpoch, std::vector<int> &path) {
+    if (!this->enabled) return false;
+
+    bool found = false;
+
+    // As consultas em lote e os agentes da simulação acessam a cache a partir de várias threads
+    {
+        std::lock_guard<std::mutex> lock(*this->mutex);
+        Store &store = this->getStore(considerPolygons, currentEpoch);
+
+        if (const auto it = store.exact.find({source, target, algorithm}); it != store.exact.end()) {
+            path = store.paths[it->second];
+            this->stats.hits++;
+            found = true;
+        } else if (const auto suffix = store.suffixes.find({source, target, algorithm}); suffix != store.suffixes.end()) {
+            const std::vector<int> &cached = store.paths[suffix->second.entry];
+            path.assign(cached.begin() + suffix->second.offset, cached.end());
+            this->stats.suffixHits++;
+            found = true;
+        } else {
+            this->stats.misses++;
+        }
+
+        if (found && this->stats.misses > 0) {
+            this->stats.savedUs += this->stats.missUs / this->stats.misses;
+        }
+    }
+
+    return found;
+}
+
+void RouteCache::insert(const int source, const int target, const int algorithm, const bool considerPolygons,
+                        const long long currentEpoch, const std::vector<int> &path, const bool reusable,
+                        const double computeUs) {
+    if (!this->enabled) return;
+
+    {
+        std::lock_guard<std::mutex> lock(*this->mutex);
+        this->stats.missUs += computeUs;
+
+        Store &store = this->getStore(considerPolygons, currentEpoch);
+
+        // Limite de memória: recomeça a cache em vez de controlar a ordem de uso
+        if (store.paths.size() >= maxPaths) {
+            store.clear();
+        }
+
+        const int entry = static_cast<int>(store.paths.size());
+        store.paths.push_back(path);
+        store.exact[{source, target, algorithm}] = entry;
+
+        // Cada vértice intermediário passa a apontar para o restante do caminho
+        if (reusable) {
+            for (int i = 0; i + 1 < static_cast<int>(path.size()); i++) {
+                store.suffixes[{path[i], target, algorithm}] = {entry, i + 1};
+            }
+        }
+    }
+}
+
+void RouteCache::clear() {
+    this->stores[0].clear();
+    this->stores[1].clear();
+    this->epoch = -1;
+    this->stats = Stats();
+}
@@ -0,0 +1,98 @@
+#ifndef PROJETOCONCLUSAOCURSO_ROUTE_CACHE_H
+#define PROJETOCONCLUSAOCURSO_ROUTE_CACHE_H
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+// Cache de rotas por (origem, destino, algoritmo) e época dos bloqueios
+// As rotas sem polígonos valem para sempre, as com polígonos apenas enquanto a época não muda.
+// Todo sufixo de um caminho mínimo também é mínimo, então uma consulta cuja origem aparece em um
+// caminho guardado para o mesmo destino reaproveita o restante dele
+class RouteCache {
+public:
+    struct Stats {
+        long long hits = 0;             // Consultas respondidas por um caminho guardado com a mesma origem
+        long long suffixHits = 0;       // Consultas respondidas pelo sufixo de outro caminho
+        long long misses = 0;
+        double missUs = 0.0;            // Tempo gasto nas consultas que não estavam na cache
+        double savedUs = 0.0;           // Estimativa (tempo médio de uma consulta calculada por acerto)
+
+        Stats &operator+=(const Stats &other) {
+            this->hits += other.hits;
+            this->suffixHits += other.suffixHits;
+            this->misses += other.misses;
+            this->missUs += other.missUs;
+            this->savedUs += other.savedUs;
+            return *this;
+        }
+    };
+
+private:
+    struct Key {
+        int node;
+        int target;
+        int algorithm;
+
+        bool operator==(const Key &other) const {
+            return node == other.node && target == other.target && algorithm == other.algorithm;
+        }
+
+        class Hash {
+        public:
+            std::size_t operator()(const Key &k) const {
+                return std::hash<long long>()((static_cast<long long>(k.node) << 32) ^ k.target) ^
+                       (std::hash<int>()(k.algorithm) << 1);
+            }
+        };
+    };
+
+    struct SuffixRef {
+        int entry;                      // Caminho guardado que passa pelo vértice
+        int offset;                     // Posição do primeiro vértice do sufixo
+    };
+
+    // Caminhos de um tipo de consulta (sem ou com polígonos)
+    struct Store {
+        std::vector<std::vector<int>> paths;
+        std::unordered_map<Key, int, Key::Hash> exact;
+        std::unordered_map<Key, SuffixRef, Key::Hash> suffixes;
+
+        void clear() {
+            this->paths.clear();
+            this->exact.clear();
+            this->suffixes.clear();
+        }
+    };
+
+    static constexpr std::size_t maxPaths = 1 << 14;
+
+    Store stores[2];                    // [0] sem polígonos, [1] com polígonos
+    long long epoch = -1;               // Época dos caminhos com polígonos guardados
+    bool enabled = true;
+    Stats stats;
+    // Cada grafo tem a própria cache; a trava só serializa as threads que consultam o mesmo grafo
+    std::unique_ptr<std::mutex> mutex = std::make_unique<std::mutex>();
+
+    Store &getStore(bool considerPolygons, long long currentEpoch);
+
+public:
+    // Procura o caminho (sem a origem) de source até target, falso se não estiver na cache
+    bool lookup(int source, int target, int algorithm, bool considerPolygons, long long currentEpoch, std::vector<int> &path);
+
+    // Guarda o caminho calculado; reusable indica se os sufixos dele também são caminhos mínimos
+    void insert(int source, int target, int algorithm, bool considerPolygons, long long currentEpoch,
+                const std::vector<int> &path, bool reusable, double computeUs);
+
+    void clear();
+    void setEnabled(const bool value) { this->enabled = value; }
+    bool isEnabled() const { return this->enabled; }
+    const Stats &getStats() const { return this->stats; }
+    // Soma as estatísticas de outra cache (execuções de um teste)
+    void addStats(const Stats &other) { this->stats += other; }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_ROUTE_CACHE_H
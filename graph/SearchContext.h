@@ -0,0 +1,177 @@
+#ifndef PROJETOCONCLUSAOCURSO_SEARCH_CONTEXT_H
+#define PROJETOCONCLUSAOCURSO_SEARCH_CONTEXT_H
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "SearchQueues.h"
+
+
+// Área de trabalho das buscas (A*) reutilizada entre consultas da mesma thread
+// Cada vértice guarda a geração em que foi escrito, então reiniciar a busca é O(1):
+// valores de gerações anteriores são tratados como "não visitado"
+// A fila é escolhida por consulta e as cópias antigas das filas preguiçosas nunca chegam a quem busca
+class SearchContext {
+public:
+    // Fila usada pela busca: heap binário (preguiçoso), heap 4-ário com decrease-key ou radix heap (chaves monótonas)
+    enum QueueType { BinaryHeap, QuaternaryHeap, RadixHeap };
+
+private:
+    std::vector<double> gCosts;
+    std::vector<int> previous;
+    std::vector<double> queuedKeys;     // Última chave inserida de cada vértice (NaN depois de removido)
+    std::vector<unsigned> stamp;        // Geração em que cada vértice foi tocado
+    unsigned generation = 0;
+
+    std::vector<int> touched;           // Vértices tocados pela consulta atual
+    int settled = 0;                    // Vértices expandidos pela consulta atual
+    long long pushes = 0;               // Inserções na fila pela consulta atual
+
+    QueueType queueType = BinaryHeap;
+    BinaryHeapQueue binaryHeap;         // Armazenamento das filas reaproveitado entre consultas
+    QuaternaryHeapQueue quaternaryHeap;
+    RadixHeapQueue radixHeap;
+
+    bool rawEmpty() const {
+        switch (this->queueType) {
+            case QuaternaryHeap: return this->quaternaryHeap.empty();
+            case RadixHeap: return this->radixHeap.empty();
+            default: return this->binaryHeap.empty();
+        }
+    }
+
+    // As filas preguiçosas podem ter cópias antigas de um vértice, que são descartadas aqui
+    void discardStale() {
+        if (this->queueType == QuaternaryHeap) return;
+
+        while (!this->rawEmpty()) {
+            const bool radix = this->queueType == RadixHeap;
+            const int id = radix ? this->radixHeap.topId() : this->binaryHeap.topId();
+            const double key = radix ? this->radixHeap.topKey() : this->binaryHeap.topKey();
+            if (this->queuedKeys[id] == key) return;
+
+            if (radix) this->radixHeap.pop();
+            else this->binaryHeap.pop();
+        }
+    }
+
+public:
+    // Garante espaço para o grafo e inicia uma nova consulta
+    void reset(const int numNodes, const QueueType type = BinaryHeap) {
+        if (static_cast<int>(this->stamp.size()) < numNodes) {
+            this->gCosts.resize(numNodes);
+            this->previous.resize(numNodes);
+            this->queuedKeys.resize(numNodes);
+            this->stamp.resize(numNodes, 0);
+        }
+
+        this->generation++;
+
+        // Estouro do contador: limpa os carimbos uma única vez
+        if (this->generation == 0) {
+            std::fill(this->stamp.begin(), this->stamp.end(), 0);
+            this->generation = 1;
+        }
+
+        this->touched.clear();
+        this->settled = 0;
+        this->pushes = 0;
+
+        this->queueType = type;
+        switch (type) {
+            case QuaternaryHeap: this->quaternaryHeap.reset(numNodes); break;
+            case RadixHeap: this->radixHeap.reset(numNodes); break;
+            default: this->binaryHeap.reset(numNodes); break;
+        }
+    }
+
+    double getCost(const int node) const {
+        return this->stamp[node] == this->generation ? this->gCosts[node] : INFINITY;
+    }
+
+    int getPrevious(const int node) const {
+        return this->stamp[node] == this->generation ? this->previous[node] : -1;
+    }
+
+    void update(const int node, const double cost, const int prev) {
+        if (this->stamp[node] != this->generation) {
+            this->stamp[node] = this->generation;
+            this->touched.push_back(node);
+        }
+
+        this->gCosts[node] = cost;
+        this->previous[node] = prev;
+    }
+
+    const std::vector<int> &getTouched() const { return this->touched; }
+
+    void markSettled() { this->settled++; }
+    int getSettled() const { return this->settled; }
+    long long getPushes() const { return this->pushes; }
+    QueueType getQueueType() const { return this->queueType; }
+
+    bool queueEmpty() {
+        this->discardStale();
+        return this->rawEmpty();
+    }
+
+    // Insere o vértice (já atualizado com update) ou diminui a chave dele
+    void push(const int id, const double key) {
+        this->queuedKeys[id] = key;
+        this->pushes++;
+
+        switch (this->queueType) {
+            case QuaternaryHeap: this->quaternaryHeap.push(id, key); break;
+            case RadixHeap: this->radixHeap.push(id, key); break;
+            default: this->binaryHeap.push(id, key); break;
+        }
+    }
+
+    // Menor chave da fila (a fila não pode estar vazia)
+    double topKey() {
+        this->discardStale();
+
+        switch (this->queueType) {
+            case QuaternaryHeap: return this->quaternaryHeap.topKey();
+            case RadixHeap: return this->radixHeap.topKey();
+            default: return this->binaryHeap.topKey();
+        }
+    }
+
+    // Remove o vértice de menor chave, o custo dele fica em getCost
+    int pop() {
+        this->discardStale();
+
+        int id;
+        switch (this->queueType) {
+            case QuaternaryHeap: id = this->quaternaryHeap.pop(); break;
+            case RadixHeap: id = this->radixHeap.pop(); break;
+            default: id = this->binaryHeap.pop(); break;
+        }
+
+        this->queuedKeys[id] = NAN;
+        return id;
+    }
+
+    // Reconstroi o caminho (sem a origem) a partir dos predecessores
+    std::vector<int> extractPath(const int source, const int target) const {
+        std::vector<int> path;
+
+        if (this->getPrevious(target) == -1) {
+            return path;
+        }
+
+        int current = target;
+        while (current != source && this->getPrevious(current) != -1) {
+            path.push_back(current);
+            current = this->getPrevious(current);
+        }
+
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_SEARCH_CONTEXT_H
@@ -0,0 +1,235 @@
+#ifndef PROJETOCONCLUSAOCURSO_SEARCH_QUEUES_H
+#define PROJETOCONCLUSAOCURSO_SEARCH_QUEUES_H
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+// Filas de prioridade das buscas (chave double, vértice int)
+// Todas expõem a mesma interface: reset, empty, push, topId, topKey e pop
+struct QueueEntry {
+    double key;
+    int id;
+
+    bool operator>(const QueueEntry &other) const { return key > other.key; }
+};
+
+
+// Heap binário com remoção preguiçosa: um vértice pode aparecer mais de uma vez (quem usa descarta as cópias antigas)
+class BinaryHeapQueue {
+    std::vector<QueueEntry> heap;
+
+public:
+    void reset(int) { this->heap.clear(); }
+    bool empty() const { return this->heap.empty(); }
+    std::size_t size() const { return this->heap.size(); }
+
+    void push(const int id, const double key) {
+        this->heap.push_back({key, id});
+        std::push_heap(this->heap.begin(), this->heap.end(), std::greater<>());
+    }
+
+    int topId() const { return this->heap.front().id; }
+    double topKey() const { return this->heap.front().key; }
+
+    int pop() {
+        std::pop_heap(this->heap.begin(), this->heap.end(), std::greater<>());
+        const int id = this->heap.back().id;
+        this->heap.pop_back();
+        return id;
+    }
+};
+
+
+// Heap 4-ário indexado com decrease-key: cada vértice aparece no máximo uma vez
+// Com 4 filhos por nível a árvore tem metade da altura e os filhos ficam na mesma linha de cache
+class QuaternaryHeapQueue {
+    std::vector<QueueEntry> heap;
+    std::vector<int> position;          // Posição de cada vértice no heap (-1 se já saiu)
+    std::vector<unsigned> stamp;        // Geração em que a posição foi escrita
+    unsigned generation = 0;
+
+    void siftUp(int i) {
+        const QueueEntry entry = this->heap[i];
+        while (i > 0) {
+            const int parent = (i - 1) / 4;
+            if (this->heap[parent].key <= entry.key) break;
+
+            this->heap[i] = this->heap[parent];
+            this->position[this->heap[i].id] = i;
+            i = parent;
+        }
+
+        this->heap[i] = entry;
+        this->position[entry.id] = i;
+    }
+
+    void siftDown(int i) {
+        const QueueEntry entry = this->heap[i];
+        const int size = static_cast<int>(this->heap.size());
+
+        while (true) {
+            const int first = 4 * i + 1;
+            if (first >= size) break;
+
+            // Menor entre os (até) quatro filhos
+            int best = first;
+            const int last = std::min(first + 4, size);
+            for (int child = first + 1; child < last; child++) {
+                if (this->heap[child].key < this->heap[best].key) best = child;
+            }
+
+            if (entry.key <= this->heap[best].key) break;
+
+            this->heap[i] = this->heap[best];
+            this->position[this->heap[i].id] = i;
+            i = best;
+        }
+
+        this->heap[i] = entry;
+        this->position[entry.id] = i;
+    }
+
+public:
+    void reset(const int numNodes) {
+        if (static_cast<int>(this->stamp.size()) < numNodes) {
+            this->position.resize(numNodes);
+            this->stamp.resize(numNodes, 0);
+        }
+
+        this->generation++;
+        if (this->generation == 0) {
+            std::fill(this->stamp.begin(), this->stamp.end(), 0);
+            this->generation = 1;
+        }
+
+        this->heap.clear();
+    }
+
+    bool empty() const { return this->heap.empty(); }
+    std::size_t size() const { return this->heap.size(); }
+
+    // Insere o vértice ou atualiza a chave dele se já estiver no heap
+    void push(const int id, const double key) {
+        if (this->stamp[id] == this->generation && this->position[id] != -1) {
+            const int i = this->position[id];
+            const bool decreased = key < this->heap[i].key;
+            this->heap[i].key = key;
+
+            if (decreased) this->siftUp(i);
+            else this->siftDown(i);
+            return;
+        }
+
+        this->stamp[id] = this->generation;
+        this->heap.push_back({key, id});
+        this->siftUp(static_cast<int>(this->heap.size()) - 1);
+    }
+
+    int topId() const { return this->heap.front().id; }
+    double topKey() const { return this->heap.front().key; }
+
+    int pop() {
+        const int id = this->heap.front().id;
+        this->position[id] = -1;
+
+        const QueueEntry last = this->heap.back();
+        this->heap.pop_back();
+
+        if (!this->heap.empty()) {
+            this->heap[0] = last;
+            this->siftDown(0);
+        }
+
+        return id;
+    }
+};
+
+
+// Radix heap para chaves monótonas (a chave inserida nunca é menor que a última removida)
+// As chaves não negativas são comparadas pelos bits do double e cada entrada fica no balde do bit mais
+// significativo em que difere da última chave removida, então cada entrada é redistribuída no máximo 64 vezes.
+// Só serve para buscas com heurística consistente: uma chave abaixo da última removida além do arredondamento
+// (tolerance) interrompe a execução no assert; dentro dele é tratada como igual à última.
+// Também usa remoção preguiçosa: quem usa descarta as cópias antigas
+class RadixHeapQueue {
+public:
+    static constexpr double tolerance = 1e-9;   // Erro relativo aceito nas somas g + h
+
+private:
+    std::array<std::vector<QueueEntry>, 65> buckets;
+    std::uint64_t last = 0;             // Bits da última chave removida
+    std::size_t count = 0;
+
+    std::uint64_t bits(const double key) const {
+        const std::uint64_t value = std::bit_cast<std::uint64_t>(key > 0.0 ? key : 0.0);
+        return std::max(value, this->last);
+    }
+
+    int bucketIndex(const std::uint64_t value) const {
+        return value == this->last ? 0 : 64 - std::countl_zero(value ^ this->last);
+    }
+
+    // Garante que o balde 0 tem as entradas de menor chave
+    void refill() {
+        if (!this->buckets[0].empty()) return;
+
+        int i = 1;
+        while (this->buckets[i].empty()) i++;
+
+        std::uint64_t minimum = UINT64_MAX;
+        for (const QueueEntry &entry : this->buckets[i]) {
+            minimum = std::min(minimum, this->bits(entry.key));
+        }
+
+        this->last = minimum;
+        for (const QueueEntry &entry : this->buckets[i]) {
+            this->buckets[this->bucketIndex(this->bits(entry.key))].push_back(entry);
+        }
+        this->buckets[i].clear();
+    }
+
+public:
+    void reset(int) {
+        for (auto &bucket : this->buckets) bucket.clear();
+        this->last = 0;
+        this->count = 0;
+    }
+
+    bool empty() const { return this->count == 0; }
+    std::size_t size() const { return this->count; }
+
+    void push(const int id, const double key) {
+        const double lastKey = std::bit_cast<double>(this->last);
+        assert(key >= lastKey || (std::isfinite(lastKey) && lastKey - key <= tolerance * std::max(1.0, lastKey)));
+
+        this->buckets[this->bucketIndex(this->bits(key))].push_back({key, id});
+        this->count++;
+    }
+
+    int topId() {
+        this->refill();
+        return this->buckets[0].back().id;
+    }
+
+    double topKey() {
+        this->refill();
+        return this->buckets[0].back().key;
+    }
+
+    int pop() {
+        this->refill();
+        const int id = this->buckets[0].back().id;
+        this->buckets[0].pop_back();
+        this->count--;
+        return id;
+    }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_SEARCH_QUEUES_H
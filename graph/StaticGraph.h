@@ -0,0 +1,28 @@
+#ifndef PROJETOCONCLUSAOCURSO_STATIC_GRAPH_H
+#define PROJETOCONCLUSAOCURSO_STATIC_GRAPH_H
+#include <limits>
+
+#include "ContractionHierarchy.h"
+#include "Landmarks.h"
+#include "RoadNetwork.h"
+
+
+// Parte do grafo que não muda durante os testes: malha, ordem e atalhos da CCH com a métrica sem polígonos e as
+// tabelas dos landmarks. É montada uma única vez (leitura, congelamento e preparações) e depois compartilhada,
+// somente leitura, por todas as execuções criadas com DynamicGraph::createTrial
+// A grade das arestas fica fora: a resolução dela depende do raio dos polígonos de cada cenário
+struct StaticGraph {
+    RoadNetwork network;                                // Malha viária em CSR (índices densos)
+
+    double minLon = std::numeric_limits<double>::infinity();
+    double maxLon = -std::numeric_limits<double>::infinity();
+    double minLat = std::numeric_limits<double>::infinity();
+    double maxLat = -std::numeric_limits<double>::infinity();
+
+    ContractionHierarchy hierarchy;                     // CCH (topologia fixa da malha)
+    ContractionHierarchy::Metric staticMetric;          // Pesos sem considerar os polígonos
+    Landmarks landmarks;                                // Tabelas de distância da heurística ALT
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_STATIC_GRAPH_H
@@ -0,0 +1,31 @@
+#ifndef PROJETOCONCLUSAOCURSO_BITMAP_H
+#define PROJETOCONCLUSAOCURSO_BITMAP_H
+#include <cstdint>
+#include <vector>
+
+
+// Vetor de bits de tamanho fixo (um bit por vértice/aresta/célula)
+class Bitmap {
+    std::vector<std::uint64_t> words;
+    int numBits = 0;
+
+public:
+    Bitmap() = default;
+    explicit Bitmap(const int numBits) : words((numBits + 63) / 64, 0), numBits(numBits) {}
+
+    void resize(const int newNumBits) {
+        this->words.assign((newNumBits + 63) / 64, 0);
+        this->numBits = newNumBits;
+    }
+
+    int size() const { return this->numBits; }
+
+    bool test(const int i) const { return (this->words[i >> 6] >> (i & 63)) & 1ULL; }
+    void set(const int i) { this->words[i >> 6] |= 1ULL << (i & 63); }
+    void reset(const int i) { this->words[i >> 6] &= ~(1ULL << (i & 63)); }
+
+    std::size_t memoryUsage() const { return this->words.capacity() * sizeof(std::uint64_t); }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_BITMAP_H
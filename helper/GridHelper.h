@@ -4,70 +4,18 @@
 
 #ifndef PROJETOCONCLUSAOCURSO_GRID_HELPER_H
 #define PROJETOCONCLUSAOCURSO_GRID_HELPER_H
-#include <unordered_set>
-#include <vector>
+#include <cmath>
 
-#include "./PointHelper.h"
 #include "../geometry/Cell.h"
-#include "../geometry/Polygon.h"
-#include "../geometry/UniformGrid.h"
+#include "../geometry/Point.h"
 
 
 class GridHelper {
 public:
-    // Retonra as células ocupadas por todos os polígonos
-    static std::vector<Cell> getOccupiedCells(const std::vector<Polygon> &polygons, const UniformGrid &grid) {
-        std::unordered_set<Cell, Cell::Hash> occupiedCellsSet;
-
-        for (const auto &polygon : polygons) {
-            std::unordered_set<Cell, Cell::Hash> cells = getOccupiedCells(polygon, grid);
-            occupiedCellsSet.insert(cells.begin(), cells.end());
-        }
-
-        return {occupiedCellsSet.begin(), occupiedCellsSet.end()};
-    }
-
-    // Retorna as células ocupadas por um polígono específico
-    static std::unordered_set<Cell, Cell::Hash> getOccupiedCells(const Polygon &polygon, const UniformGrid &grid) {
-        std::unordered_set<Cell, Cell::Hash> occupiedCellsSet;
-
-        if (polygon.getPoints().empty()) {
-            return occupiedCellsSet;
-        }
-
-        // Constroi a caixa delimitadora do polígono
-        double minX = std::numeric_limits<double>::infinity();
-        double maxX = -std::numeric_limits<double>::infinity();
-        double minY = std::numeric_limits<double>::infinity();
-        double maxY = -std::numeric_limits<double>::infinity();
-
-        for (const auto &p : polygon.getPoints()) {
-            minX = std::min(minX, p.getX());
-            minY = std::min(minY, p.getY());
-            maxX = std::max(maxX, p.getX());
-            maxY = std::max(maxY, p.getY());
-        }
-
-        const double cellSize = grid.getCellSize();
-        const int iMin = static_cast<int>(std::floor(minX / cellSize));
-        const int iMax = static_cast<int>(std::floor(maxX / cellSize));
-        const int jMin = static_cast<int>(std::floor(minY / cellSize));
-        const int jMax = static_cast<int>(std::floor(maxY / cellSize));
-
-        // Adiciona todas essas células no set de retorno
-        for (int i = iMin; i <= iMax; i++) {
-            for (int j = jMin; j <= jMax; j++) {
-                occupiedCellsSet.insert(Cell(i, j));
-            }
-        }
-
-        return occupiedCellsSet;
-    }
-
     // Retorna a célula em que o ponto se encontra
     static Cell getCellPoint(const Point &point, const double cellSize) {
-        const int cellI = static_cast<int>(floor(point.getX() / cellSize));
-        const int cellJ = static_cast<int>(floor(point.getY() / cellSize));
+        const int cellI = static_cast<int>(std::floor(point.getX() / cellSize));
+        const int cellJ = static_cast<int>(std::floor(point.getY() / cellSize));
         return {cellI, cellJ};
     }
 };
@@ -0,0 +1,73 @@
+#ifndef PROJETOCONCLUSAOCURSO_PHILOX_H
+#define PROJETOCONCLUSAOCURSO_PHILOX_H
+#include <array>
+#include <cstdint>
+
+
+// Gerador Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+// O resultado depende apenas da chave (semente + tipo da sequência) e do contador, sem estado compartilhado:
+// cada polígono/tick/agente tem a própria sequência, independente da thread que a consome e da ordem.
+// O primeiro termo do contador numera os blocos de 4 valores, os outros três identificam a sequência
+class Philox {
+public:
+    // Tipos de sequência (fazem parte da chave, então nunca se sobrepõem para a mesma semente)
+    enum Stream : std::uint32_t { PolygonMotion = 1, PolygonPlacement = 2, AgentPlacement = 3, NodeSample = 4 };
+
+private:
+    static constexpr std::uint32_t multiplier0 = 0xD2511F53;
+    static constexpr std::uint32_t multiplier1 = 0xCD9E8D57;
+    static constexpr std::uint32_t weyl0 = 0x9E3779B9;
+    static constexpr std::uint32_t weyl1 = 0xBB67AE85;
+
+    std::array<std::uint32_t, 2> key;
+    std::array<std::uint32_t, 4> counter;
+    std::array<std::uint32_t, 4> block{};
+    int used = 4;                       // Valores do bloco atual já consumidos
+
+    void refill() {
+        std::array<std::uint32_t, 4> x = this->counter;
+        std::array<std::uint32_t, 2> k = this->key;
+
+        for (int round = 0; round < 10; round++) {
+            const std::uint64_t p0 = static_cast<std::uint64_t>(multiplier0) * x[0];
+            const std::uint64_t p1 = static_cast<std::uint64_t>(multiplier1) * x[2];
+            x = {static_cast<std::uint32_t>(p1 >> 32) ^ x[1] ^ k[0], static_cast<std::uint32_t>(p1),
+                 static_cast<std::uint32_t>(p0 >> 32) ^ x[3] ^ k[1], static_cast<std::uint32_t>(p0)};
+            k[0] += weyl0;
+            k[1] += weyl1;
+        }
+
+        this->block = x;
+        this->counter[0]++;
+        this->used = 0;
+    }
+
+public:
+    Philox(const std::uint64_t seed, const Stream stream, const std::uint32_t a, const std::uint32_t b = 0,
+           const std::uint32_t c = 0)
+        : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) + stream * weyl0},
+          counter{0, a, b, c} {}
+
+    std::uint32_t next() {
+        if (this->used == 4) this->refill();
+        return this->block[this->used++];
+    }
+
+    // Uniforme em [0, 1) com 53 bits
+    double nextDouble() {
+        const std::uint64_t high = this->next() >> 5;
+        const std::uint64_t low = this->next() >> 6;
+        return static_cast<double>(high << 26 | low) * 0x1.0p-53;
+    }
+
+    double uniform(const double min, const double max) { return min + (max - min) * this->nextDouble(); }
+
+    // Uniforme em [min, max]
+    int uniformInt(const int min, const int max) {
+        const auto value = min + static_cast<long long>(this->nextDouble() * (static_cast<double>(max) - min + 1.0));
+        return static_cast<int>(value > max ? max : value);
+    }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_PHILOX_H
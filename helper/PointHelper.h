@@ -71,6 +71,37 @@ public:
 
         return R * c;
     }
+
+    // Mesma conta de haversineDistance com latitude/longitude em radianos e cos(latitude) já calculados
+    // (o resultado é idêntico, apenas sem as conversões e os dois cossenos)
+    static double haversineRadians(const double lat1, const double lon1, const double cosLat1,
+                                   const double lat2, const double lon2, const double cosLat2) {
+        constexpr double R = 6371000.0;
+
+        const double dLat = lat2 - lat1;
+        const double dLon = lon2 - lon1;
+
+        const double a = std::sin(dLat / 2) * std::sin(dLat / 2) +
+                         cosLat1 * cosLat2 *
+                         std::sin(dLon / 2) * std::sin(dLon / 2);
+
+        const double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+
+        return R * c;
+    }
+
+    // Corda entre dois pontos da esfera (vetores unitários): nunca maior que o arco de haversine
+    // e sem funções trigonométricas, então é um limite inferior barato para distâncias urbanas
+    static double chordDistance(const double x1, const double y1, const double z1,
+                                const double x2, const double y2, const double z2) {
+        constexpr double R = 6371000.0;
+
+        const double dx = x1 - x2;
+        const double dy = y1 - y2;
+        const double dz = z1 - z2;
+
+        return R * std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
 };
 
 
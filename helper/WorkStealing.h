@@ -0,0 +1,103 @@
+#ifndef PROJETOCONCLUSAOCURSO_WORK_STEALING_H
+#define PROJETOCONCLUSAOCURSO_WORK_STEALING_H
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <omp.h>
+
+
+// Distribui os índices [0, count) entre as threads do OpenMP com roubo de trabalho
+// Cada thread começa pela própria fatia contígua e, quando ela acaba, rouba metade do que resta da fatia de
+// outra thread. Indicado quando o custo por índice varia muito e fica concentrado em poucos índices
+// (schedule(dynamic) faz todas as threads disputarem um único contador)
+class WorkStealing {
+    // Intervalo [begin, end) ainda não processado de uma fatia, em um único valor atômico (begin nos 32 bits altos)
+    struct alignas(64) Range {
+        std::atomic<std::uint64_t> bounds{0};
+    };
+
+    std::unique_ptr<Range[]> ranges;
+    int numRanges = 0;
+    long long steals = 0;               // Roubos bem-sucedidos desde a criação
+
+    static std::uint64_t pack(const std::uint32_t begin, const std::uint32_t end) {
+        return static_cast<std::uint64_t>(begin) << 32 | end;
+    }
+    static std::uint32_t getBegin(const std::uint64_t bounds) { return static_cast<std::uint32_t>(bounds >> 32); }
+    static std::uint32_t getEnd(const std::uint64_t bounds) { return static_cast<std::uint32_t>(bounds); }
+
+    // Retira o primeiro índice da própria fatia
+    bool pop(const int thread, int &index) {
+        std::atomic<std::uint64_t> &bounds = this->ranges[thread].bounds;
+        std::uint64_t current = bounds.load();
+
+        while (getBegin(current) < getEnd(current)) {
+            if (bounds.compare_exchange_weak(current, pack(getBegin(current) + 1, getEnd(current)))) {
+                index = static_cast<int>(getBegin(current));
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Move a metade final da fatia de outra thread para a própria fatia (false se todas estão vazias)
+    bool steal(const int thread, const int threads) {
+        for (int offset = 1; offset < threads; offset++) {
+            std::atomic<std::uint64_t> &victim = this->ranges[(thread + offset) % threads].bounds;
+            std::uint64_t current = victim.load();
+
+            while (getBegin(current) < getEnd(current)) {
+                const std::uint32_t begin = getBegin(current);
+                const std::uint32_t end = getEnd(current);
+                const std::uint32_t half = end - (end - begin + 1) / 2;
+
+                if (victim.compare_exchange_weak(current, pack(begin, half))) {
+                    this->ranges[thread].bounds.store(pack(half, end));
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+public:
+    // Chama work(i) uma vez para cada i em [0, count); numThreads <= 0 usa todas as threads do OpenMP
+    template <typename Work>
+    void run(const int count, const int numThreads, Work &&work) {
+        const int threads = numThreads > 0 ? numThreads : omp_get_max_threads();
+        if (threads > this->numRanges) {
+            this->ranges = std::make_unique<Range[]>(threads);
+            this->numRanges = threads;
+        }
+
+        for (int t = 0; t < threads; t++) {
+            const auto begin = static_cast<std::uint32_t>(static_cast<long long>(count) * t / threads);
+            const auto end = static_cast<std::uint32_t>(static_cast<long long>(count) * (t + 1) / threads);
+            this->ranges[t].bounds.store(pack(begin, end));
+        }
+
+        // Se o OpenMP criar menos threads que o pedido, as fatias sem dona são esvaziadas por roubo
+        long long stolen = 0;
+        #pragma omp parallel num_threads(threads) reduction(+:stolen)
+        {
+            const int thread = omp_get_thread_num();
+            int index;
+
+            while (true) {
+                while (this->pop(thread, index)) work(index);
+
+                if (!this->steal(thread, threads)) break;
+                stolen++;
+            }
+        }
+
+        this->steals += stolen;
+    }
+
+    long long getSteals() const { return this->steals; }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_WORK_STEALING_H
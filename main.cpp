@@ -1,13 +1,29 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <fstream>
 #include <iostream>
-
-#include "geometry/Polygon.h"
+#include <limits>
+#include <omp.h>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+#include "benchmark/Benchmark.h"
+#include "geometry/FixedPolygon.h"
 #include "graph/DynamicGraph.h"
 #include "screen/Agent.h"
 #include "screen/Screen.h"
+#include "simulation/Simulation.h"
+
+// Matriz dos testes quando não existe uma salva: todos os vértices até este limite (4 bytes por par, 256 MB)
+// Acima dele os vértices são sorteados e os pares fora da matriz são verificados com uma busca
+constexpr int maxDefaultMatrixNodes = 8192;
+// Menor frota do modo simulate (as seguintes dobram até --agents)
+constexpr int minSimulationAgents = 64;
 
 // Faz a leitura do grafo
-void initGraph(DynamicGraph &graph, std::ifstream &inputFile) {
+void initGraph(DynamicGraph &graph, std::ifstream &inputFile, const double polygonRadius) {
     int numPoints;
     int numEdges;
 
@@ -32,26 +48,43 @@ void initGraph(DynamicGraph &graph, std::ifstream &inputFile) {
     }
 
     inputFile.close();
+
+    // Congela a malha em CSR (os ids do OpenStreetMap ficam apenas na borda)
+    // A resolução da grade depende da densidade das arestas e do raio dos polígonos
+    graph.freeze(polygonRadius);
 }
 
-// Faz um ciclo de execução (para um teste)
-void runTest(DynamicGraph &graph, std::ofstream &csvFile, const int numPolygons, const double polygonRadius) {
+// Faz um ciclo de execução (para um teste) no grafo da execução, escrevendo uma linha do CSV
+void runTest(DynamicGraph &graph, std::ostream &csvFile, const int numPolygons, const double polygonRadius,
+             const DynamicGraph::SearchAlgorithm algorithm, const DistanceMatrix &matrix) {
     graph.clearPolygons();
+    Philox placement(graph.getSeed(), Philox::PolygonPlacement, graph.getTrial());
     for(int i = 0; i < numPolygons; i++) {
-        graph.addPolygon(Polygon::generateHexInGrid(graph.getUniformGrid(), polygonRadius));
+        graph.addPolygon(Hexagon::generateInGrid(graph.getUniformGrid(), polygonRadius, placement));
     }
 
-    const auto agents = Agent::initAgents(graph);
+    // Estatísticas da cache de rotas antes do teste (o CSV registra apenas as deste teste)
+    const RouteCache::Stats cacheBefore = graph.getRouteCacheStats();
+
+    const auto agents = Agent::initAgents(graph, algorithm, &matrix);
     const Agent* dynamicAgent = agents.at(0);
     const Agent* staticAgent = agents.at(1);
 
     bool running = true;
 
     while (running) {
-        graph.updatePolygonsPosition();
+        // Enquanto os dois agentes apenas percorrem arestas nenhum deles consulta os bloqueios: os polígonos e os
+        // agentes avançam direto até o próximo evento (chegada a um vértice), com o mesmo resultado tick a tick
+        int ticks = std::numeric_limits<int>::max();
+        for (const auto &agent : agents) {
+            ticks = std::min(ticks, agent->getTicksUntilDecision(graph));
+        }
+        ticks = std::max(ticks, 1);
+
+        graph.updatePolygonsPosition(ticks);
 
         for (auto &agent : agents) {
-            agent->move(graph);
+            agent->move(graph, ticks);
         }
 
         const bool dynamicArrived = (dynamicAgent->getCurrentId() == dynamicAgent->getEndId());
@@ -64,30 +97,215 @@ void runTest(DynamicGraph &graph, std::ofstream &csvFile, const int numPolygons,
             << staticAgent->aStarQnt << ';' << staticAgent->processTimeMS << ';'
             << dynamicAgent->moves << ';' << dynamicAgent->dist << ';'
             << dynamicAgent->aStarQnt << ';' << dynamicAgent->processTimeMS << ';'
-            << (dynamicAgent->moves == staticAgent->moves ? '0' : dynamicAgent->moves < staticAgent->moves ? '1' : '2') << '\n';
+            << (dynamicAgent->moves == staticAgent->moves ? '0' : dynamicAgent->moves < staticAgent->moves ? '1' : '2') << ';';
+
+    const RouteCache::Stats &cacheAfter = graph.getRouteCacheStats();
+    csvFile << cacheAfter.hits - cacheBefore.hits << ';' << cacheAfter.suffixHits - cacheBefore.suffixHits << ';'
+            << cacheAfter.misses - cacheBefore.misses << ';' << (cacheAfter.savedUs - cacheBefore.savedUs) / 1000.0 << ';';
+
+    // Distância mínima sem polígonos (consulta na matriz, -1 se o par não estiver nela)
+    // Soma dos pesos das arestas do arquivo de entrada, enquanto DistStatic/DistDynamic somam a haversine
+    const int startIndex = matrix.indexOf(staticAgent->getStartId());
+    const int endIndex = matrix.indexOf(staticAgent->getEndId());
+    csvFile << (startIndex >= 0 && endIndex >= 0 ? matrix.getDistance(startIndex, endIndex) : -1.0) << '\n';
 
     delete dynamicAgent;
     delete staticAgent;
 }
 
-// Roda uma quantidade de testes armazenando os resultados em um csv
-void runTest(DynamicGraph &graph, const int numPolygons, const double polygonRadius) {
-    std::ofstream csvFile("resultados_" + std::to_string(numPolygons) + "poligonos_raio" + std::to_string(polygonRadius) + "_tcc.csv");
+// Cenário de testes: quantidade e raio dos polígonos e quantos testes rodar
+struct TestScenario {
+    int numPolygons;
+    double polygonRadius;
+    int numTrials;
+};
+
+// Cabeçalho das colunas escritas por runTest
+// As distâncias dos agentes são a haversine ao longo do caminho percorrido; a de referência (matriz) é a soma
+// dos pesos das arestas da entrada, por isso o nome da coluna indica a unidade diferente
+void writeTestHeader(std::ostream &csvFile) {
     csvFile << "TicksStatic;DistStatic;AStarQntStatic;ProcessTimeMSStatic;";
-    csvFile << "TicksDynamic;DistDynamic;AStarQntDynamic;ProcessTimeMSDynamic;Result\n";
+    csvFile << "TicksDynamic;DistDynamic;AStarQntDynamic;ProcessTimeMSDynamic;Result;";
+    csvFile << "CacheHits;CacheSuffixHits;CacheMisses;CacheSavedMS;BaselineEdgeWeightDist\n";
+}
+
+// Roda os testes de todos os cenários em paralelo sobre a mesma malha, escrevendo as linhas na ordem
+// (cenário, teste). Cada teste tem o próprio grafo de execução (polígonos, bloqueios, cache e sequências do
+// teste i, iguais entre cenários). Com scenarioColumns as linhas começam pelo cenário e seus parâmetros
+// Retorna o tempo total em segundos
+double runTests(DynamicGraph &graph, std::ostream &csvFile, const std::vector<TestScenario> &scenarios,
+                const DynamicGraph::SearchAlgorithm algorithm, const DistanceMatrix &matrix, const int numThreads,
+                const bool verbose, const bool scenarioColumns) {
+    // As estruturas compartilhadas (CCH, landmarks) ficam prontas antes das execuções
+    graph.prepareQueries(algorithm);
+
+    // A grade define onde os polígonos podem ser colocados e para onde podem se mover, então cada raio usa a
+    // grade que um teste isolado com ele usaria (apenas a malha e as preparações são compartilhadas)
+    std::vector<double> radii;
+    std::vector<DynamicGraph> radiusGraphs;
+    std::vector<int> scenarioGraph(scenarios.size());
+    for (int s = 0; s < static_cast<int>(scenarios.size()); s++) {
+        const auto it = std::find(radii.begin(), radii.end(), scenarios[s].polygonRadius);
+        scenarioGraph[s] = static_cast<int>(it - radii.begin());
+
+        if (it == radii.end()) {
+            radii.push_back(scenarios[s].polygonRadius);
+            radiusGraphs.push_back(graph.withPolygonRadius(scenarios[s].polygonRadius));
+        }
+    }
+
+    // Todos os testes de todos os cenários em uma única lista, na ordem de escrita
+    std::vector<std::pair<int, int>> tasks;
+    for (int s = 0; s < static_cast<int>(scenarios.size()); s++) {
+        for (int i = 0; i < scenarios[s].numTrials; i++) tasks.emplace_back(s, i);
+    }
 
-    for(int i = 0; i < 500; i++) {
-        runTest(graph, csvFile, numPolygons, polygonRadius);
-        std::cout << "Rodando teste: " << i << '\n';
+    const int numTasks = static_cast<int>(tasks.size());
+    std::vector<std::string> rows(numTasks);
+    std::vector<char> finished(numTasks, 0);
+    int nextRow = 0;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Os testes têm durações muito diferentes, então são distribuídos um a um
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads > 0 ? numThreads : omp_get_max_threads())
+    for (int t = 0; t < numTasks; t++) {
+        const auto [s, i] = tasks[t];
+        const TestScenario &scenario = scenarios[s];
+
+        DynamicGraph trialGraph = radiusGraphs[scenarioGraph[s]].createTrial(i);
+        std::ostringstream row;
+        if (scenarioColumns) row << s << ';' << scenario.numPolygons << ';' << scenario.polygonRadius << ';' << i << ';';
+        runTest(trialGraph, row, scenario.numPolygons, scenario.polygonRadius, algorithm, matrix);
+
+        // Escreve todas as linhas já concluídas em sequência a partir da próxima esperada
+        #pragma omp critical(test_rows)
+        {
+            rows[t] = row.str();
+            finished[t] = 1;
+            graph.addTrialStatistics(trialGraph);
+            while (nextRow < numTasks && finished[nextRow]) {
+                csvFile << rows[nextRow];
+                std::string().swap(rows[nextRow]);
+                nextRow++;
+            }
+
+            if (verbose) {
+                if (scenarioColumns) std::cout << "Rodando cenario " << s << ", teste: " << i << '\n';
+                else std::cout << "Rodando teste: " << i << '\n';
+            }
+        }
     }
 
+    const auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+// Cache de rotas somada em todos os testes já executados sobre o grafo
+void reportRouteCache(const DynamicGraph &graph) {
+    const RouteCache::Stats &stats = graph.getRouteCacheStats();
+    const long long lookups = stats.hits + stats.suffixHits + stats.misses;
+
+    std::cout << "Cache de rotas: " << stats.hits << " acertos, " << stats.suffixHits << " acertos por sufixo, "
+              << stats.misses << " falhas (" << (lookups == 0 ? 0.0 : 100.0 * (stats.hits + stats.suffixHits) / lookups)
+              << "% de acertos) | " << stats.savedUs / 1000.0 << " ms economizados\n";
+}
+
+// Roda os testes armazenando os resultados em um csv
+void runTest(DynamicGraph &graph, const int numPolygons, const double polygonRadius,
+             const DynamicGraph::SearchAlgorithm algorithm, const DistanceMatrix &matrix, const int numTrials,
+             const int numThreads) {
+    std::ofstream csvFile("resultados_" + std::to_string(numPolygons) + "poligonos_raio" + std::to_string(polygonRadius) + "_tcc.csv");
+    writeTestHeader(csvFile);
+
+    const double seconds = runTests(graph, csvFile, {{numPolygons, polygonRadius, numTrials}}, algorithm, matrix,
+                                    numThreads, true, false);
+    std::cout << numTrials << " testes em " << seconds << " s\n";
+    reportRouteCache(graph);
+
+    csvFile.close();
+}
+
+// Tempo dos mesmos testes com 1, 2, 4, ... maxThreads threads (speedup em relação a uma thread)
+void reportTestScaling(DynamicGraph &graph, const int numPolygons, const double polygonRadius,
+                       const DynamicGraph::SearchAlgorithm algorithm, const DistanceMatrix &matrix, const int numTrials,
+                       const int maxThreads) {
+    double baseSeconds = 0.0;
+
+    for (int threads = 1; ; threads = std::min(threads * 2, maxThreads)) {
+        std::ostringstream discarded;
+        const double seconds = runTests(graph, discarded, {{numPolygons, polygonRadius, numTrials}}, algorithm, matrix,
+                                        threads, false, false);
+        if (threads == 1) baseSeconds = seconds;
+
+        std::cout << "Testes com " << threads << " threads: " << seconds << " s | speedup " << baseSeconds / seconds << '\n';
+        if (threads >= maxThreads) break;
+    }
+}
+
+// Lê uma lista de valores separados por vírgula, em que cada item é um valor ou um intervalo "inicio:fim:passo"
+// (fim incluído). Retorna uma lista vazia se algum item for inválido
+std::vector<double> parseValueList(const std::string &text) {
+    std::vector<double> values;
+    std::stringstream items(text);
+    std::string item;
+
+    while (std::getline(items, item, ',')) {
+        double first;
+        double last;
+        double step;
+        char separator1;
+        char separator2;
+        std::istringstream range(item);
+
+        if (range >> first && range.eof()) {
+            values.push_back(first);
+        } else if (std::istringstream(item) >> first >> separator1 >> last >> separator2 >> step &&
+                   separator1 == ':' && separator2 == ':' && step > 0.0 && last >= first) {
+            // Calcula pelo índice para não acumular erro de arredondamento no passo
+            const int count = static_cast<int>(std::floor((last - first) / step + 1e-9)) + 1;
+            for (int k = 0; k < count; k++) values.push_back(first + k * step);
+        } else {
+            return {};
+        }
+    }
+
+    return values;
+}
+
+// Roda todas as combinações de quantidades de polígonos, raios e quantidades de testes sobre o mesmo grafo,
+// com os resultados em um único csv (uma coluna identifica o cenário)
+void runSweep(DynamicGraph &graph, const std::vector<double> &polygonCounts, const std::vector<double> &radii,
+              const std::vector<double> &trialCounts, const DynamicGraph::SearchAlgorithm algorithm,
+              const DistanceMatrix &matrix, const int numThreads, const std::string &outputPath) {
+    std::vector<TestScenario> scenarios;
+    for (const double numPolygons : polygonCounts) {
+        for (const double polygonRadius : radii) {
+            for (const double numTrials : trialCounts) {
+                scenarios.push_back({static_cast<int>(numPolygons), polygonRadius, static_cast<int>(numTrials)});
+                std::cout << "Cenario " << scenarios.size() - 1 << ": " << scenarios.back().numPolygons << " poligonos, raio "
+                          << polygonRadius << ", " << scenarios.back().numTrials << " testes\n";
+            }
+        }
+    }
+
+    std::ofstream csvFile(outputPath);
+    csvFile << "Scenario;NumPolygons;Radius;Trial;";
+    writeTestHeader(csvFile);
+
+    const double seconds = runTests(graph, csvFile, scenarios, algorithm, matrix, numThreads, true, true);
+    std::cout << scenarios.size() << " cenarios em " << seconds << " s (" << outputPath << ")\n";
+    reportRouteCache(graph);
+
     csvFile.close();
 }
 
 // Modo de visualização com 100 execuções seguidas
-void displayGraph(DynamicGraph &graph, const int numPolygons, const double polygonRadius) {
+void displayGraph(DynamicGraph &graph, const int numPolygons, const double polygonRadius,
+                  const DynamicGraph::SearchAlgorithm algorithm) {
+    Philox placement(graph.getSeed(), Philox::PolygonPlacement, graph.getTrial());
     for (int i = 0; i < numPolygons; i++) {
-        Polygon poly = Polygon::generateHexInGrid(graph.getUniformGrid(), polygonRadius);
+        Hexagon poly = Hexagon::generateInGrid(graph.getUniformGrid(), polygonRadius, placement);
         poly.setDraggable(true);
         graph.addPolygon(poly);
     }
@@ -95,8 +313,10 @@ void displayGraph(DynamicGraph &graph, const int numPolygons, const double polyg
     Screen screen;
     screen.drawBackground(graph);
 
+    const std::uint64_t seed = graph.getSeed();
     for (int i = 0; i < 100; i++) {
-        std::vector<Agent*> agents = Agent::initAgents(graph);
+        graph.setRandomSeed(seed, i);
+        std::vector<Agent*> agents = Agent::initAgents(graph, algorithm);
 
         bool simulationRunning = true;
 
@@ -133,16 +353,136 @@ void displayGraph(DynamicGraph &graph, const int numPolygons, const double polyg
     }
 }
 
+// Frotas crescentes (dobrando até maxAgents) sobre a mesma quantidade de polígonos, reporta os ticks por segundo
+void runSimulation(DynamicGraph &graph, const int numPolygons, const double polygonRadius,
+                   const DynamicGraph::SearchAlgorithm algorithm, const DistanceMatrix &matrix, const int maxAgents,
+                   const double dynamicShare, const int numTicks, const int numThreads) {
+    int numAgents = std::min(minSimulationAgents, maxAgents);
+    const std::uint64_t seed = graph.getSeed();
+
+    while (true) {
+        // Todas as frotas partem dos mesmos polígonos e dividem os primeiros agentes
+        graph.setRandomSeed(seed);
+        graph.clearPolygons();
+        Philox placement(seed, Philox::PolygonPlacement, graph.getTrial());
+        for (int i = 0; i < numPolygons; i++) {
+            graph.addPolygon(Hexagon::generateInGrid(graph.getUniformGrid(), polygonRadius, placement));
+        }
+
+        Simulation simulation(graph, algorithm, numThreads);
+
+        const auto initStart = std::chrono::high_resolution_clock::now();
+        simulation.addAgents(numAgents, dynamicShare, &matrix);
+        const auto start = std::chrono::high_resolution_clock::now();
+        while (simulation.getTicks() < numTicks && simulation.step()) {}
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        const double ticks = static_cast<double>(simulation.getTicks());
+        std::cout << "Agentes: " << numAgents << " (" << simulation.getNumDynamic() << " dinamicos) | inicializacao "
+                  << std::chrono::duration<double, std::milli>(start - initStart).count() << " ms | "
+                  << ticks / seconds << " ticks/s | " << simulation.getReplans() / ticks << " replanejamentos/tick | "
+                  << simulation.getNumArrived() << " chegaram em " << simulation.getTicks() << " ticks | "
+                  << simulation.getSteals() << " roubos | " << simulation.getPathAlerts() / ticks << " alertas de caminho/tick\n";
+
+        if (numAgents >= maxAgents) break;
+        numAgents = std::min(numAgents * 2, maxAgents);
+    }
+}
+
+// Calcula a matriz de distâncias entre count vértices sorteados (todos se count <= 0) e salva em path
+// useHierarchy calcula sobre a CCH (pré-processando se preciso), senão com um Dijkstra por vértice
+void buildDistanceMatrix(DynamicGraph &graph, DistanceMatrix &matrix, const int count, const std::string &path,
+                         const bool useHierarchy) {
+    Philox rng(graph.getSeed(), Philox::NodeSample, 0);
+    const std::vector<int> nodes = DistanceMatrix::sampleNodes(graph.getNetwork(), count, rng);
+    const long long elapsedUs = graph.computeDistanceMatrix(nodes, matrix, useHierarchy);
+
+    std::cout << "Matriz " << matrix.size() << 'x' << matrix.size() << " calculada em " << elapsedUs / 1000.0
+              << " ms (" << matrix.memoryUsage() / (1024.0 * 1024.0) << " MB)\n";
+
+    if (!path.empty() && !matrix.save(path)) {
+        std::cerr << "Erro ao salvar a matriz em " + path + '\n';
+    }
+}
+
+// Carrega a matriz salva pelo modo matrix ou calcula uma entre todos os vértices (limitada a maxDefaultMatrixNodes)
+// O cálculo de reserva só usa a CCH quando ela já é o algoritmo da execução (sem pré-processamento a mais)
+void loadDistanceMatrix(DynamicGraph &graph, DistanceMatrix &matrix, const std::string &path,
+                        const DynamicGraph::SearchAlgorithm algorithm) {
+    if (matrix.load(path, graph.getNetwork())) {
+        std::cout << "Matriz " << matrix.size() << 'x' << matrix.size() << " carregada de " << path << '\n';
+    } else {
+        std::cout << "Matriz " << path << " ausente ou de outra malha (rode o modo matrix antes para reaproveita-la)\n";
+        const int numNodes = graph.getNetwork().getNumNodes();
+        buildDistanceMatrix(graph, matrix, numNodes <= maxDefaultMatrixNodes ? 0 : maxDefaultMatrixNodes, "",
+                            algorithm == DynamicGraph::ContractionHierarchies);
+    }
+}
+
 int main(int argc, char* argv[]) {
-    if (argc < 5) {
-        std::cerr << "Uso: ./ProjetoConclusaoCurso <arquivo> <test|exhibition> <numPolygons> <radius>\n";
+    // Argumentos posicionais seguidos (em qualquer posição) de opções "--nome valor"
+    std::vector<std::string> args;
+    std::unordered_map<std::string, std::string> options;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--", 0) == 0 && i + 1 < argc) {
+            options[arg.substr(2)] = argv[++i];
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    if (args.size() < 4) {
+        std::cerr << "Uso: ./ProjetoConclusaoCurso <arquivo> <test|exhibition|benchmark|matrix|simulate|sweep> <numPolygons|numNodes> <radius> [astar|bidirectional|cch|alt|dstar] [numLandmarks]\n";
+        std::cerr << "Opcoes: --seed N --heuristic haversine|corda | modo simulate: --agents N --dynamic-share F --ticks N --threads N | modo test: --trials N --threads N --speedup N\n";
+        std::cerr << "Modo sweep: numPolygons, radius e --trials aceitam listas \"a,b,c\" e intervalos \"inicio:fim:passo\"; --output arquivo\n";
         return 1;
     }
 
-    std::string filename = argv[1];
-    std::string mode = argv[2];
-    int numPolygons = std::stoi(argv[3]);
-    double polygonRadius = std::stod(argv[4]);
+    std::string filename = args[0];
+    std::string mode = args[1];
+
+    // No modo sweep os polígonos, raios e quantidades de testes são listas; cada raio tem a própria grade
+    std::vector<double> polygonCounts = parseValueList(args[2]);
+    std::vector<double> radii = parseValueList(args[3]);
+    std::vector<double> trialCounts = parseValueList(options.count("trials") ? options["trials"] : "500");
+    if (polygonCounts.empty() || radii.empty() || trialCounts.empty()) {
+        std::cerr << "Lista de valores inválida!\n";
+        return 1;
+    }
+
+    int numPolygons = static_cast<int>(polygonCounts.front());
+    double polygonRadius = radii.front();
+
+    // Algoritmo de busca dos agentes (A* unidirecional por padrão)
+    DynamicGraph::SearchAlgorithm algorithm = DynamicGraph::AStar;
+    if (args.size() > 4) {
+        const std::string algorithmName = args[4];
+        if (algorithmName == "bidirectional") {
+            algorithm = DynamicGraph::BidirectionalAStar;
+        } else if (algorithmName == "cch") {
+            algorithm = DynamicGraph::ContractionHierarchies;
+        } else if (algorithmName == "alt") {
+            algorithm = DynamicGraph::AltAStar;
+        } else if (algorithmName == "dstar") {
+            algorithm = DynamicGraph::Incremental;
+        } else if (algorithmName != "astar") {
+            std::cerr << "Algoritmo inválido! Use 'astar', 'bidirectional', 'cch', 'alt' ou 'dstar'.\n";
+            return 1;
+        }
+    }
+
+    // Heurística geométrica do A*: haversine (mesmos caminhos do A* original) ou corda, mais barata
+    DynamicGraph::GeometricHeuristic heuristic = DynamicGraph::Haversine;
+    if (options.count("heuristic")) {
+        if (options["heuristic"] == "corda") {
+            heuristic = DynamicGraph::Chord;
+        } else if (options["heuristic"] != "haversine") {
+            std::cerr << "Heuristica inválida! Use 'haversine' ou 'corda'.\n";
+            return 1;
+        }
+    }
 
     std::ifstream inputFile(filename);
     if (!inputFile.is_open()) {
@@ -150,15 +490,88 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Quantidade de landmarks da heurística ALT
+    const int numLandmarks = args.size() > 5 ? std::stoi(args[5]) : Landmarks::defaultCount;
+
     DynamicGraph graph;
-    initGraph(graph, inputFile);
+    initGraph(graph, inputFile, polygonRadius);
+    graph.setGeometricHeuristic(heuristic);
+
+    // Semente global: com --seed a execução é reproduzível, sem ela é sorteada e exibida para repetir depois
+    std::uint64_t seed;
+    if (options.count("seed")) {
+        seed = std::stoull(options["seed"]);
+    } else {
+        std::random_device rd;
+        seed = static_cast<std::uint64_t>(rd()) << 32 | rd();
+    }
+    graph.setRandomSeed(seed);
+    std::cout << "Semente: " << seed << '\n';
+
+    // Pré-processamento da CCH (apenas uma vez, antes dos testes)
+    if (algorithm == DynamicGraph::ContractionHierarchies) {
+        graph.prepareContractionHierarchy();
+        std::cout << "CCH pre-processada em " << graph.getHierarchyBuildUs() / 1000.0 << " ms\n";
+    }
+
+    // Tabelas dos landmarks ficam ao lado do arquivo de entrada e são reaproveitadas nas próximas execuções
+    if (algorithm == DynamicGraph::AltAStar) {
+        const bool loaded = graph.prepareLandmarks(numLandmarks, filename + ".landmarks");
+        std::cout << numLandmarks << " landmarks " << (loaded ? "carregados" : "calculados") << " em "
+                  << graph.getLandmarksBuildUs() / 1000.0 << " ms\n";
+    }
 
-    if (mode == "test") {
-        runTest(graph, numPolygons, polygonRadius);
+    // Matriz de distâncias dos testes: reaproveita a do modo matrix ou calcula uma entre todos os vértices
+    const std::string matrixPath = filename + ".matrix";
+
+    if (mode == "matrix") {
+        DistanceMatrix matrix;
+        buildDistanceMatrix(graph, matrix, numPolygons, matrixPath, true);
+    } else if (mode == "test") {
+        DistanceMatrix matrix;
+        loadDistanceMatrix(graph, matrix, matrixPath, algorithm);
+
+        const int numTrials = static_cast<int>(trialCounts.front());
+        const int numThreads = options.count("threads") ? std::stoi(options["threads"]) : 0;
+
+        runTest(graph, numPolygons, polygonRadius, algorithm, matrix, numTrials, numThreads);
+
+        if (algorithm == DynamicGraph::ContractionHierarchies) {
+            std::cout << "CCH recustomizacao media: " << graph.getAverageCustomizationUs() << " us\n";
+        }
+
+        // Com --speedup N repete os testes com 1, 2, 4, ... N threads para medir a escalabilidade
+        if (options.count("speedup")) {
+            reportTestScaling(graph, numPolygons, polygonRadius, algorithm, matrix, numTrials, std::stoi(options["speedup"]));
+        }
+    } else if (mode == "sweep") {
+        DistanceMatrix matrix;
+        loadDistanceMatrix(graph, matrix, matrixPath, algorithm);
+
+        const int numThreads = options.count("threads") ? std::stoi(options["threads"]) : 0;
+        const std::string outputPath = options.count("output") ? options["output"] : "resultados_sweep_tcc.csv";
+
+        runSweep(graph, polygonCounts, radii, trialCounts, algorithm, matrix, numThreads, outputPath);
+
+        if (algorithm == DynamicGraph::ContractionHierarchies) {
+            std::cout << "CCH recustomizacao media: " << graph.getAverageCustomizationUs() << " us\n";
+        }
     } else if (mode == "exhibition") {
-        displayGraph(graph, numPolygons, polygonRadius);
+        displayGraph(graph, numPolygons, polygonRadius, algorithm);
+    } else if (mode == "benchmark") {
+        Benchmark::run(graph, numPolygons, polygonRadius);
+    } else if (mode == "simulate") {
+        DistanceMatrix matrix;
+        loadDistanceMatrix(graph, matrix, matrixPath, algorithm);
+
+        const int maxAgents = options.count("agents") ? std::stoi(options["agents"]) : 1024;
+        const double dynamicShare = options.count("dynamic-share") ? std::stod(options["dynamic-share"]) : 0.5;
+        const int numTicks = options.count("ticks") ? std::stoi(options["ticks"]) : 200;
+        const int numThreads = options.count("threads") ? std::stoi(options["threads"]) : 0;
+
+        runSimulation(graph, numPolygons, polygonRadius, algorithm, matrix, maxAgents, dynamicShare, numTicks, numThreads);
     } else {
-        std::cerr << "Modo inválido! Use 'test' ou 'exhibition'.\n";
+        std::cerr << "Modo inválido! Use 'test', 'exhibition', 'benchmark', 'matrix', 'simulate' ou 'sweep'.\n";
         return 1;
     }
 
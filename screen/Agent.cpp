@@ -4,36 +4,39 @@
 
 #include "Agent.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <limits>
 
 #include "../helper/GridHelper.h"
-#include "../helper/PointHelper.h"
 
-#include <random>
 
-
-Agent::Agent(DynamicGraph& graph, const Type type, const Point &currentPosition, const long long startId, const long long endId) :
+Agent::Agent(DynamicGraph& graph, const Type type, const Point &currentPosition, const int startId, const int endId,
+             const DynamicGraph::SearchAlgorithm algorithm) :
     type(type),
+    algorithm(algorithm),
     currentPosition(currentPosition),
-    path(std::vector<long long>()),
+    path(std::vector<int>()),
     startId(startId),
     currentId(startId),
     endId(endId),
     pathAgentId(0),
-    pathAgent(std::vector<long long>()),
+    pathAgent(std::vector<int>()),
     progressAlongEdge(0.0),
     currentSpeed(100),
     nextNodeId(-1),
-    isMoving(false) {
+    isMoving(false),
+    hasLastIntersection(false) {
     // Start time
     const auto start = std::chrono::high_resolution_clock::now();
 
     if (type == Static) {
         // Agente estático não considera os polígonos para encontrar o caminho
-        this->pathAgent = graph.findPathAStar(startId, endId);
+        this->pathAgent = graph.findPathAStar(startId, endId, algorithm);
     } else {
         // Agente dinâmico considera os polígonos para encontrar o caminho
-        this->pathAgent = graph.findPathAStarConsideringPolygons(startId, endId);
+        this->pathAgent = this->findDynamicPath(graph);
     }
 
     // End time
@@ -47,40 +50,49 @@ Agent::Agent(DynamicGraph& graph, const Type type, const Point &currentPosition,
     }
 }
 
-std::pair<long long, long long> Agent::chooseRandomStartAndEnd(const DynamicGraph& graph) {
+std::pair<int, int> Agent::chooseRandomStartAndEnd(const DynamicGraph& graph, Philox& rng) {
     // Escolhe de forma aleatória a posição de início e fim do agente (o caminho que ele pretende percorrer)
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
-    std::vector<long long> ids;
-    for (const auto& [id, point] : graph.getIdToPoint()) {
-        ids.push_back(id);
-    }
+    // Os índices dos vértices são densos, então basta sortear no intervalo [0, V)
+    const int numNodes = graph.getNetwork().getNumNodes();
 
-    std::uniform_int_distribution<> dist(0, static_cast<int>(ids.size() - 1));
-
-    long long startId = ids[dist(gen)];
-    long long endId = startId;
+    int startId = rng.uniformInt(0, numNodes - 1);
+    int endId = startId;
 
     while (endId == startId) {
-        endId = ids[dist(gen)];
+        endId = rng.uniformInt(0, numNodes - 1);
     }
 
     return {startId, endId};
 }
 
-std::vector<Agent*> Agent::initAgents(DynamicGraph& graph) {
-    long long startId;
-    long long endId;
+bool Agent::isReachable(DynamicGraph& graph, const DistanceMatrix* matrix, const int startId, const int endId,
+                        const DynamicGraph::SearchAlgorithm algorithm) {
+    if (matrix != nullptr) {
+        const int i = matrix->indexOf(startId);
+        const int j = matrix->indexOf(endId);
+        if (i >= 0 && j >= 0) return matrix->isReachable(i, j);
+    }
+
+    return !graph.findPathAStar(startId, endId, algorithm).empty();
+}
+
+std::vector<Agent*> Agent::initAgents(DynamicGraph& graph, const DynamicGraph::SearchAlgorithm algorithm,
+                                      const DistanceMatrix* matrix) {
+    int startId;
+    int endId;
+
+    // Garante que a fotografia dos bloqueios corresponde aos polígonos atuais
+    graph.refreshObstacleSnapshot();
 
     // Procura uma posição de início e fim que possua um caminho válido
+    Philox rng(graph.getSeed(), Philox::AgentPlacement, 0, graph.getTrial());
     do {
-        std::tie(startId, endId) = chooseRandomStartAndEnd(graph);
-    } while (graph.findPathAStar(startId, endId).empty());
+        std::tie(startId, endId) = chooseRandomStartAndEnd(graph, rng);
+    } while (!isReachable(graph, matrix, startId, endId, algorithm));
 
     // Cria os agentes e adiciona a posição inicial no caminho deles
-    auto* dynamicAgent = new Agent(graph, Dynamic, graph.getIdToPoint().at(startId), startId, endId);
-    auto* staticAgent = new Agent(graph, Static, graph.getIdToPoint().at(startId), startId, endId);
+    auto* dynamicAgent = new Agent(graph, Dynamic, graph.getPoint(startId), startId, endId, algorithm);
+    auto* staticAgent = new Agent(graph, Static, graph.getPoint(startId), startId, endId, algorithm);
 
     dynamicAgent->addPathMovent(startId);
     staticAgent->addPathMovent(startId);
@@ -88,67 +100,136 @@ std::vector<Agent*> Agent::initAgents(DynamicGraph& graph) {
     return {dynamicAgent, staticAgent};
 }
 
-void Agent::addPathMovent(long long id) {
+std::vector<Agent*> Agent::initFleet(DynamicGraph& graph, const int numAgents, const double dynamicShare,
+                                     const DynamicGraph::SearchAlgorithm algorithm, const DistanceMatrix* matrix) {
+    // Depois da preparação as buscas apenas leem o grafo
+    graph.prepareQueries(algorithm);
+
+    std::vector<Agent*> agents(numAgents);
+
+    // O custo de cada agente depende do tamanho do caminho inicial, então a distribuição é dinâmica
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int i = 0; i < numAgents; i++) {
+        int startId;
+        int endId;
+
+        // Sequência própria do agente: a frota é a mesma para qualquer quantidade de threads
+        Philox rng(graph.getSeed(), Philox::AgentPlacement, i, graph.getTrial());
+        do {
+            std::tie(startId, endId) = chooseRandomStartAndEnd(graph, rng);
+        } while (!isReachable(graph, matrix, startId, endId, algorithm));
+
+        // O agente i é dinâmico quando a fração acumulada passa de um inteiro (tipos espalhados pela frota)
+        const bool dynamic = std::floor((i + 1) * dynamicShare) > std::floor(i * dynamicShare);
+
+        agents[i] = new Agent(graph, dynamic ? Dynamic : Static, graph.getPoint(startId), startId, endId, algorithm);
+        agents[i]->addPathMovent(startId);
+    }
+
+    return agents;
+}
+
+void Agent::addPathMovent(const int id) {
     this->path.push_back(id);
 }
 
-void Agent::setCurrentId(const DynamicGraph& graph, long long id) {
+void Agent::setCurrentId(const DynamicGraph& graph, const int id) {
     this->currentId = id;
-    this->currentPosition = graph.getIdToPoint().at(id);
+    this->currentPosition = graph.getPoint(id);
 }
 
-void Agent::updateOccupiedCellsCache(const DynamicGraph& graph) {
-    bool changed = false;
-    const auto& polygons = graph.getPolygons();
-
-    #pragma omp parallel for
-    for (int i = 0; i < polygons.size(); i++) {
-        const Polygon& poly = polygons[i];
-        auto newCells = GridHelper::getOccupiedCells(poly, graph.getUniformGrid());
-
-        #pragma omp critical(cache_access)
-        {
-            // Se não possui o polígono na cache ou se as células dele são diferentes da iteração anterior
-            // Adiciona essas novas células e invalida a cache
-            const auto it = this->polygonToCellsCache.find(i);
-            if (it == this->polygonToCellsCache.end() || it->second != newCells) {
-                this->polygonToCellsCache[i] = std::move(newCells);
-                changed = true;
-            }
-        }
+std::vector<int> Agent::findDynamicPath(DynamicGraph& graph) {
+    // O D* Lite repara a árvore do agente, os demais algoritmos refazem a busca do zero
+    if (this->algorithm == DynamicGraph::Incremental) {
+        return graph.findPathIncremental(this->planner, this->currentId, this->endId);
     }
 
-    // Atualiza a cache
-    if (changed) {
-        this->lastOccupiedCells.clear();
-        for (const auto& [id, cells] : this->polygonToCellsCache) {
-            this->lastOccupiedCells.insert(cells.begin(), cells.end());
-        }
-    }
+    return graph.findPathAStarConsideringPolygons(this->currentId, this->endId, this->algorithm);
 }
 
-bool Agent::isPointSafeCache(const Point& point, const DynamicGraph& graph) {
-    const Cell pointCell = GridHelper::getCellPoint(point, graph.getUniformGrid().getCellSize());
+bool Agent::isPointSafeCache(const int id, const DynamicGraph& graph) {
+    const Cell pointCell = GridHelper::getCellPoint(graph.getPoint(id), graph.getUniformGrid().getCellSize());
 
-    // Se não possui essa célula na cache é um ponto "seguro"
-    if (!this->lastOccupiedCells.contains(pointCell)) {
+    // Se nenhum polígono ocupa essa célula (índice espacial do grafo) é um ponto "seguro"
+    if (!graph.isCellOccupied(pointCell)) {
         return true;
     }
 
-    // Caso possua precisa validar se realmente é uma interseção
-    for (const Polygon& polygon : graph.getPolygons()) {
-        if (PointHelper::pointInConvexPolygon(polygon.getPoints(), point)) {
-            this->lastIntersectionCell = pointCell;
-            this->hasLastIntersection = true;
-            return false;
-        }
+    // Caso possua precisa validar se realmente é uma interseção (fotografia dos bloqueios do tick)
+    if (graph.isNodeBlocked(id)) {
+        this->lastIntersectionCell = pointCell;
+        this->hasLastIntersection = true;
+        return false;
     }
 
     this->hasLastIntersection = false;
     return true;
 }
 
-void Agent::move(DynamicGraph& graph) {
+void Agent::updatePathCells(const DynamicGraph& graph) {
+    const UniformGrid &grid = graph.getUniformGrid();
+    const double cellSize = grid.getCellSize();
+    this->pathCells.clear();
+
+    // Células da caixa de cada passo: contêm os vértices e qualquer ponto em que a aresta cruze um polígono
+    int previousId = this->currentId;
+    for (int i = this->pathAgentId; i < static_cast<int>(this->pathAgent.size()); i++) {
+        const Point u = graph.getPoint(previousId);
+        const Point v = graph.getPoint(this->pathAgent[i]);
+
+        const int iMin = static_cast<int>(std::floor(std::min(u.getX(), v.getX()) / cellSize));
+        const int iMax = static_cast<int>(std::floor(std::max(u.getX(), v.getX()) / cellSize));
+        const int jMin = static_cast<int>(std::floor(std::min(u.getY(), v.getY()) / cellSize));
+        const int jMax = static_cast<int>(std::floor(std::max(u.getY(), v.getY()) / cellSize));
+
+        for (int ci = iMin; ci <= iMax; ci++) {
+            for (int cj = jMin; cj <= jMax; cj++) {
+                const int cell = grid.getCellIndex(Cell(ci, cj));
+                if (cell >= 0) this->pathCells.push_back({cell, i});
+            }
+        }
+
+        previousId = this->pathAgent[i];
+    }
+
+    // Cada célula fica uma vez, com o último passo que a usa; a ordem por passo permite descartar do início
+    // as células que o agente já deixou para trás
+    std::sort(this->pathCells.begin(), this->pathCells.end(), [](const PathCell &a, const PathCell &b) {
+        return a.cell != b.cell ? a.cell < b.cell : a.lastStep > b.lastStep;
+    });
+    this->pathCells.erase(std::unique(this->pathCells.begin(), this->pathCells.end(),
+                                      [](const PathCell &a, const PathCell &b) { return a.cell == b.cell; }),
+                          this->pathCells.end());
+    std::sort(this->pathCells.begin(), this->pathCells.end(), [](const PathCell &a, const PathCell &b) {
+        return a.lastStep < b.lastStep;
+    });
+    this->pathChanged = true;
+}
+
+void Agent::subscribePath(const DynamicGraph& graph) {
+    this->subscribed = true;
+    this->updatePathCells(graph);
+}
+
+int Agent::getTicksUntilDecision(const DynamicGraph& graph) const {
+    if (this->currentId == this->endId) return std::numeric_limits<int>::max();
+    if (!this->isMoving) return 0;
+
+    // Repete a mesma soma de move (e não uma divisão) para chegar exatamente no mesmo tick
+    const double edgeDistance = graph.getNetwork().haversineDistance(this->currentId, this->nextNodeId);
+    const double progressIncrement = this->currentSpeed / edgeDistance;
+    double progress = this->progressAlongEdge;
+    int ticks = 0;
+
+    while (progress < 1.0) {
+        progress += progressIncrement;
+        ticks++;
+    }
+
+    return ticks;
+}
+
+void Agent::move(DynamicGraph& graph, const int ticks) {
     // Se já chegou ao destino não precisa movimentar
     if (this->currentId == this->endId) {
         this->isMoving = false;
@@ -157,26 +238,35 @@ void Agent::move(DynamicGraph& graph) {
 
     // Start time
     const auto start = std::chrono::high_resolution_clock::now();
-    this->moves++;
+    this->moves += ticks;
 
     // Se não está movendo precisa definir o seu próximo movimento
     if (!this->isMoving) {
         if (this->type == Dynamic) {
             bool currentPathValid = !this->pathAgent.empty();
 
-            if (currentPathValid) {
-                this->updateOccupiedCellsCache(graph);
+            // Inscrito na simulação: se nenhum polígono ocupa as células do caminho, nenhum passo está bloqueado
+            const bool mustValidate = !this->subscribed || this->occupiedPathCells > 0;
 
+            if (currentPathValid && mustValidate) {
                 // Se alguma posição do trajeto possuir uma interseção com o polígono vai recalcular o seu caminho
                 for (int i = this->pathAgentId; i < this->pathAgent.size(); i++) {
-                    const Cell pointCell = GridHelper::getCellPoint(graph.getIdToPoint().at(this->pathAgent[i]), graph.getUniformGrid().getCellSize());
+                    const Point pathPoint = graph.getPoint(this->pathAgent[i]);
+                    const Cell pointCell = GridHelper::getCellPoint(pathPoint, graph.getUniformGrid().getCellSize());
 
                     // Se a interseção é a mesma da anterior, não precisa recalcula o caminho pois o resultado será praticamente igual
                     if (this->hasLastIntersection && this->lastIntersectionCell == pointCell) {
                         break;
                     }
 
-                    if (!isPointSafeCache(graph.getIdToPoint().at(this->pathAgent[i]), graph)) {
+                    if (!isPointSafeCache(this->pathAgent[i], graph)) {
+                        currentPathValid = false;
+                        break;
+                    }
+
+                    // A aresta até esse ponto pode atravessar um polígono mesmo com as extremidades livres
+                    const int previousId = i == this->pathAgentId ? this->currentId : this->pathAgent[i - 1];
+                    if (graph.isStepBlocked(previousId, this->pathAgent[i])) {
                         currentPathValid = false;
                         break;
                     }
@@ -186,26 +276,18 @@ void Agent::move(DynamicGraph& graph) {
             // Recalcula o caminho e
             if (!currentPathValid) {
                 this->aStarQnt++;
-                this->pathAgent = graph.findPathAStarConsideringPolygons(this->currentId, this->endId);
+                this->pathAgent = this->findDynamicPath(graph);
                 this->pathAgentId = 0;
+                if (this->subscribed) this->updatePathCells(graph);
             }
         }
 
         // Se possui um caminho
         if (!this->pathAgent.empty() && this->pathAgentId < this->pathAgent.size()) {
             this->nextNodeId = this->pathAgent[this->pathAgentId];
-            const Point& currentPoint = graph.getIdToPoint().at(this->currentId);
-            const Point& nextPoint = graph.getIdToPoint().at(this->nextNodeId);
-            bool validPath = true;
 
             // Valida se o próximo passo é válido (pois ainda sim pode acabar ficando preso nos congestionamentos)
-            for (const Polygon& polygon : graph.getPolygons()) {
-                if (PointHelper::pointInConvexPolygon(polygon.getPoints(), currentPoint) ||
-                    PointHelper::pointInConvexPolygon(polygon.getPoints(), nextPoint)) {
-                    validPath = false;
-                    break;
-                }
-            }
+            const bool validPath = !graph.isStepBlocked(this->currentId, this->nextNodeId);
 
             if (validPath) {
                 this->isMoving = true;
@@ -216,12 +298,15 @@ void Agent::move(DynamicGraph& graph) {
 
     if (this->isMoving) {
         // Faz uma interpolação linear para o movimento
-        const Point& startPoint = graph.getIdToPoint().at(this->currentId);
-        const Point& endPoint = graph.getIdToPoint().at(this->nextNodeId);
+        const Point startPoint = graph.getPoint(this->currentId);
+        const Point endPoint = graph.getPoint(this->nextNodeId);
 
-        const double edgeDistance = PointHelper::haversineDistance(startPoint, endPoint);
+        // Termos trigonométricos pré-calculados na malha (mesmo valor da haversine a partir dos pontos)
+        const double edgeDistance = graph.getNetwork().haversineDistance(this->currentId, this->nextNodeId);
         const double progressIncrement = this->currentSpeed / edgeDistance;
-        this->progressAlongEdge += progressIncrement;
+        for (int t = 0; t < ticks; t++) {
+            this->progressAlongEdge += progressIncrement;
+        }
 
         const double newX = startPoint.getX() + (endPoint.getX() - startPoint.getX()) * this->progressAlongEdge;
         const double newY = startPoint.getY() + (endPoint.getY() - startPoint.getY()) * this->progressAlongEdge;
@@ -4,47 +4,64 @@
 
 #ifndef PROJETOCONCLUSAOCURSO_AGENT_H
 #define PROJETOCONCLUSAOCURSO_AGENT_H
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "../graph/DynamicGraph.h"
+#include "../helper/Philox.h"
 
 
 class Agent {
 public:
     enum Type { Dynamic, Static };      // Tipos de agentes
 
+    // Célula (índice denso da grade) do caminho planejado e o último passo (posição em pathAgent) que a usa
+    struct PathCell {
+        int cell;
+        int lastStep;
+    };
+
 private:
     Type type;
+    DynamicGraph::SearchAlgorithm algorithm;    // Algoritmo usado nas buscas do agente
     Point currentPosition;              // Posição atual do agente
-    std::vector<long long> path;        // Caminho já percorrido
-    long long startId;
-    long long currentId;
-    long long endId;
+    std::vector<int> path;              // Caminho já percorrido
+    int startId;
+    int currentId;
+    int endId;
 
-    std::vector<long long> pathAgent;   // Caminho que pretende percorrer
+    std::vector<int> pathAgent;         // Caminho que pretende percorrer
     int pathAgentId;                    // Posição no caminho que pretende percorrer
 
     double progressAlongEdge;           // O quanto já percorreu da aresta atual
     double currentSpeed;                // Velocidade que percorre a aresta
-    long long nextNodeId;               // Próximo id para percorrer
+    int nextNodeId;                     // Próximo id para percorrer
     bool isMoving;                      // Se está se movimentado
 
-    // Cache/Otimização
-    std::unordered_set<Cell, Cell::Hash> lastOccupiedCells;
-    std::unordered_map<int, std::unordered_set<Cell, Cell::Hash>> polygonToCellsCache;
+    DStarLite planner;                  // Árvore mantida entre os replanejamentos (algoritmo Incremental)
 
+    // Última interseção encontrada no caminho (evita recalcular pelo mesmo bloqueio)
     Cell lastIntersectionCell;
     bool hasLastIntersection;
 
-    explicit Agent(DynamicGraph &graph, Type type, const Point &currentPosition, long long startId,
-                   long long endId);
+    // Inscrição no índice célula -> agentes de uma Simulation: o caminho só é validado enquanto algum polígono
+    // ocupa uma das células em que o agente está inscrito (contagem mantida pela simulação)
+    bool subscribed = false;
+    int occupiedPathCells = 0;
+    bool pathChanged = false;           // Células do caminho mudaram desde a última leitura pela simulação
+    std::vector<PathCell> pathCells;    // Células do restante do caminho planejado, em ordem de lastStep
+
+    explicit Agent(DynamicGraph &graph, Type type, const Point &currentPosition, int startId,
+                   int endId, DynamicGraph::SearchAlgorithm algorithm);
 
-    static std::pair<long long, long long> chooseRandomStartAndEnd(const DynamicGraph& graph);
+    static std::pair<int, int> chooseRandomStartAndEnd(const DynamicGraph& graph, Philox& rng);
+    // Consulta na matriz quando os dois vértices estão nela, senão uma busca sem polígonos
+    static bool isReachable(DynamicGraph& graph, const DistanceMatrix* matrix, int startId, int endId,
+                            DynamicGraph::SearchAlgorithm algorithm);
 
-    bool isPointSafeCache(const Point& point, const DynamicGraph& graph);
-    void updateOccupiedCellsCache(const DynamicGraph& graph);
+    std::vector<int> findDynamicPath(DynamicGraph& graph);
+    bool isPointSafeCache(int id, const DynamicGraph& graph);
+    void updatePathCells(const DynamicGraph& graph);
 
 public:
     ~Agent() = default;
@@ -54,17 +71,45 @@ public:
     int aStarQnt = 1;
     long long processTimeMS = 0;
 
-    static std::vector<Agent*> initAgents(DynamicGraph& graph);
-    void addPathMovent(long long id);
-    void setCurrentId(const DynamicGraph& graph, long long id);
-    void move(DynamicGraph& graph);
+    // O par é sorteado entre todos os vértices; a matriz de distâncias apenas responde a alcançabilidade dos pares
+    // que estão nela (o mesmo par com ou sem a matriz)
+    // O sorteio usa a semente e a execução do grafo (setRandomSeed), o agente i da execução é sempre o mesmo
+    static std::vector<Agent*> initAgents(DynamicGraph& graph,
+                                          DynamicGraph::SearchAlgorithm algorithm = DynamicGraph::AStar,
+                                          const DistanceMatrix* matrix = nullptr);
+    // Frota de numAgents agentes, cada um com a própria origem e destino (caminhos iniciais em paralelo)
+    // A fração dynamicShare é de agentes dinâmicos, intercalados com os estáticos
+    static std::vector<Agent*> initFleet(DynamicGraph& graph, int numAgents, double dynamicShare,
+                                         DynamicGraph::SearchAlgorithm algorithm = DynamicGraph::AStar,
+                                         const DistanceMatrix* matrix = nullptr);
+    void addPathMovent(int id);
+    void setCurrentId(const DynamicGraph& graph, int id);
+    // ticks > 1 avança vários ticks de uma vez, válido apenas até getTicksUntilDecision (o agente só percorre a aresta)
+    void move(DynamicGraph& graph, int ticks = 1);
+    // Ticks em que o agente apenas percorre a aresta atual, incluindo o da chegada ao vértice
+    // 0 se o próximo tick precisa consultar os bloqueios, INT_MAX se já chegou ao destino
+    int getTicksUntilDecision(const DynamicGraph& graph) const;
+
+    // Passa a validar o caminho apenas quando markPathConflict for chamado (agentes dinâmicos)
+    void subscribePath(const DynamicGraph& graph);
+    void addOccupiedPathCells(const int delta) { this->occupiedPathCells += delta; }
+    // Se o caminho (e suas células) mudou desde a última chamada
+    bool consumePathChanged() {
+        const bool changed = this->pathChanged;
+        this->pathChanged = false;
+        return changed;
+    }
+    const std::vector<PathCell> &getPathCells() const { return this->pathCells; }
+    // Posição em pathAgent do próximo passo (os passos anteriores já foram percorridos)
+    int getPathIndex() const { return this->pathAgentId; }
 
     const Type &getType() const { return this->type; }
+    DynamicGraph::SearchAlgorithm getAlgorithm() const { return this->algorithm; }
     const Point &getCurrentPosition() const { return this->currentPosition; }
-    const std::vector<long long> &getPath() const { return this->path; }
-    long long getStartId() const { return this->startId; }
-    long long getCurrentId() const { return this->currentId; }
-    long long getEndId() const { return this->endId; }
+    const std::vector<int> &getPath() const { return this->path; }
+    int getStartId() const { return this->startId; }
+    int getCurrentId() const { return this->currentId; }
+    int getEndId() const { return this->endId; }
 };
 
 
@@ -66,7 +66,7 @@ void Screen::drawBackgroundGrid(const DynamicGraph &graph) {
             sf::RectangleShape cellShape(sf::Vector2f(bottomRight.x - topLeft.x, bottomRight.y - topLeft.y));
             cellShape.setPosition(topLeft);
 
-            if (!graph.getUniformGrid().getGrid().contains(c) || graph.getUniformGrid().getGrid().find(c)->second.empty()) {
+            if (!graph.getUniformGrid().hasEdges(c)) {
                 cellShape.setFillColor(sf::Color(255, 200, 200, 200));
             } else {
                 cellShape.setFillColor(sf::Color::Transparent);
@@ -81,14 +81,17 @@ void Screen::drawBackgroundGrid(const DynamicGraph &graph) {
 
 // Desenha as arestas na textura de fundo fixa
 void Screen::drawBackgroundEdges(const DynamicGraph &graph) {
-    for (auto &[id, edges]: graph.getAdj()){
-        for (const auto &edge : edges) {
-            const sf::Vertex line[] = {
-                sf::Vertex(latLonToScreen(graph, edge.getU()->getX(), edge.getU()->getY()), sf::Color::Black),
-                sf::Vertex(latLonToScreen(graph, edge.getV()->getX(), edge.getV()->getY()), sf::Color::Black)
-            };
-            this->backgroundTexture.draw(line, 2, sf::Lines);
-        }
+    const RoadNetwork &network = graph.getNetwork();
+
+    for (int e = 0; e < network.getNumEdges(); e++) {
+        const Point u = network.getPoint(network.getEdgeSource(e));
+        const Point v = network.getPoint(network.getEdgeTarget(e));
+
+        const sf::Vertex line[] = {
+            sf::Vertex(latLonToScreen(graph, u.getX(), u.getY()), sf::Color::Black),
+            sf::Vertex(latLonToScreen(graph, v.getX(), v.getY()), sf::Color::Black)
+        };
+        this->backgroundTexture.draw(line, 2, sf::Lines);
     }
 }
 
@@ -102,25 +105,19 @@ void Screen::drawBackground(const DynamicGraph &graph) {
 }
 
 // Desenha de vermelho as arestas que possuem interseção com os polígonos
-// Utiliza a grade unifrome para acelerar esse cálculo
+// Utiliza a fotografia dos bloqueios do tick (montada a partir da grade uniforme)
 void Screen::drawEdges(const DynamicGraph &graph) {
-    for (const auto &cell : GridHelper::getOccupiedCells(graph.getPolygons(), graph.getUniformGrid())) {
-        const auto it = graph.getUniformGrid().getGrid().find(cell);
-
-        if (it != graph.getUniformGrid().getGrid().end()) {
-            for (const auto edge : it->second) {
-                for (const auto &polygon : graph.getPolygons()) {
-                    if (PointHelper::pointInConvexPolygon(polygon.getPoints(), *edge->getU()) ||
-                        PointHelper::pointInConvexPolygon(polygon.getPoints(), *edge->getV())) {
-                        const sf::Vertex line[] = {
-                            sf::Vertex(latLonToScreen(graph, edge->getU()->getX(), edge->getU()->getY()), sf::Color::Red),
-                            sf::Vertex(latLonToScreen(graph, edge->getV()->getX(), edge->getV()->getY()), sf::Color::Red)
-                        };
-                        this->window.draw(line, 2, sf::Lines);
-                    }
-                }
-            }
-        }
+    const RoadNetwork &network = graph.getNetwork();
+
+    for (const int edge : graph.getObstacleSnapshot().getBlockedEdges()) {
+        const Point u = network.getPoint(network.getEdgeSource(edge));
+        const Point v = network.getPoint(network.getEdgeTarget(edge));
+
+        const sf::Vertex line[] = {
+            sf::Vertex(latLonToScreen(graph, u.getX(), u.getY()), sf::Color::Red),
+            sf::Vertex(latLonToScreen(graph, v.getX(), v.getY()), sf::Color::Red)
+        };
+        this->window.draw(line, 2, sf::Lines);
     }
 }
 
@@ -129,11 +126,11 @@ void Screen::drawPolygons(const DynamicGraph &graph) {
     for (auto &poly : graph.getPolygons()) {
         sf::ConvexShape shape;
 
-        const size_t n = poly.getPoints().size();
+        const int n = poly.getNumVertices();
         shape.setPointCount(n);
 
-        for (size_t i = 0; i < n; i++) {
-            sf::Vector2f pos = latLonToScreen(graph, poly.getPoints()[i].getX(), poly.getPoints()[i].getY());
+        for (int i = 0; i < n; i++) {
+            sf::Vector2f pos = latLonToScreen(graph, poly.getVertexX(i), poly.getVertexY(i));
             shape.setPoint(i, pos);
         }
 
@@ -158,15 +155,15 @@ void Screen::drawAgents(const DynamicGraph& graph, const std::vector<Agent*>& ag
         sf::Color pathColor = agent->getType() == Agent::Dynamic ? sf::Color::Magenta : sf::Color::Blue;
 
         for (size_t i = 0; i < agent->getPath().size() - 1; i++) {
-            long long id1 = agent->getPath()[i];
-            long long id2 = agent->getPath()[i + 1];
+            const int id1 = agent->getPath()[i];
+            const int id2 = agent->getPath()[i + 1];
 
-            const Point* p1 = &graph.getIdToPoint().at(id1);
-            const Point* p2 = &graph.getIdToPoint().at(id2);
+            const Point p1 = graph.getPoint(id1);
+            const Point p2 = graph.getPoint(id2);
 
             sf::RectangleShape pathSegment;
-            sf::Vector2f start = latLonToScreen(graph, p1->getX(), p1->getY());
-            sf::Vector2f end = latLonToScreen(graph, p2->getX(), p2->getY());
+            sf::Vector2f start = latLonToScreen(graph, p1.getX(), p1.getY());
+            sf::Vector2f end = latLonToScreen(graph, p2.getX(), p2.getY());
 
             sf::Vector2f direction = end - start;
             float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
@@ -196,12 +193,12 @@ void Screen::drawAgents(const DynamicGraph& graph, const std::vector<Agent*>& ag
 
     if (agents.empty()) return;
 
-    const long long destId = agents[0]->getEndId();
-    if (destId == -1 || !graph.getIdToPoint().contains(destId)) {
+    const int destId = agents[0]->getEndId();
+    if (destId < 0 || destId >= graph.getNetwork().getNumNodes()) {
         return;
     }
 
-    const Point& dest = graph.getIdToPoint().at(destId);
+    const Point dest = graph.getPoint(destId);
     const sf::Vector2f screenPos = latLonToScreen(graph, dest.getX(), dest.getY());
 
     sf::CircleShape destShape(8.0f);
@@ -213,9 +210,15 @@ void Screen::drawAgents(const DynamicGraph& graph, const std::vector<Agent*>& ag
     this->window.draw(destShape);
 }
 
-Polygon* getPolygonAtPosition(const DynamicGraph &graph, const float worldX, const float worldY) {
-    for (auto& polygons = const_cast<std::vector<Polygon>&>(graph.getPolygons()); auto& poly : polygons) {
-        if (poly.getDraggable() && poly.containsPoint(worldX, worldY)) {
+Hexagon* getPolygonAtPosition(const DynamicGraph &graph, const float worldX, const float worldY) {
+    // Testa apenas os polígonos que ocupam a célula do ponto
+    const Cell cell = GridHelper::getCellPoint({-1, worldX, worldY}, graph.getUniformGrid().getCellSize());
+    const std::vector<int> *candidates = graph.getPolygonIndex().polygonsAt(cell);
+    if (candidates == nullptr) return nullptr;
+
+    auto& polygons = const_cast<std::vector<Hexagon>&>(graph.getPolygons());
+    for (const int id : *candidates) {
+        if (Hexagon &poly = polygons[id]; poly.getDraggable() && poly.containsPoint(worldX, worldY)) {
             return &poly;
         }
     }
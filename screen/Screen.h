@@ -24,7 +24,7 @@ class Screen {
     sf::Sprite background;
     sf::View view;
 
-    Polygon* draggedPolygon = nullptr;
+    Hexagon* draggedPolygon = nullptr;
     sf::Vector2f lastMousePos;
 
     sf::Vector2f latLonToScreen(const DynamicGraph &graph, double lon, double lat) const;
@@ -0,0 +1,155 @@
+#include "Simulation.h"
+
+#include <algorithm>
+#include <omp.h>
+
+Simulation::Simulation(DynamicGraph &graph, const DynamicGraph::SearchAlgorithm algorithm, const int numThreads) :
+    graph(graph),
+    algorithm(algorithm),
+    numThreads(numThreads) {}
+
+Simulation::~Simulation() {
+    for (const Agent *agent : this->agents) {
+        delete agent;
+    }
+}
+
+void Simulation::addAgents(const int count, const double dynamicShare, const DistanceMatrix *matrix) {
+    const std::vector<Agent*> fleet = Agent::initFleet(this->graph, count, dynamicShare, this->algorithm, matrix);
+    const int first = static_cast<int>(this->agents.size());
+    this->agents.insert(this->agents.end(), fleet.begin(), fleet.end());
+
+    #pragma omp parallel for schedule(dynamic, 16) num_threads(this->numThreads > 0 ? this->numThreads : omp_get_max_threads())
+    for (int i = first; i < static_cast<int>(this->agents.size()); i++) {
+        if (this->agents[i]->getType() == Agent::Dynamic) this->agents[i]->subscribePath(this->graph);
+    }
+
+    this->updateSubscriptions();
+}
+
+void Simulation::subscribeCell(const int agent, const int cell) {
+    this->cellSubscribers[cell].push_back(agent);
+    if (this->occupiedCells.test(cell)) this->agents[agent]->addOccupiedPathCells(1);
+}
+
+void Simulation::unsubscribeCell(const int agent, const int cell) {
+    // Poucos agentes por célula: troca com o último e remove
+    std::vector<int> &list = this->cellSubscribers[cell];
+    const auto pos = std::find(list.begin(), list.end(), agent);
+    if (pos != list.end()) {
+        *pos = list.back();
+        list.pop_back();
+    }
+
+    if (this->occupiedCells.test(cell)) this->agents[agent]->addOccupiedPathCells(-1);
+}
+
+void Simulation::unsubscribe(const int agent) {
+    const std::vector<Agent::PathCell> &cells = this->agentCells[agent];
+    for (int k = this->agentCellsBegin[agent]; k < static_cast<int>(cells.size()); k++) {
+        this->unsubscribeCell(agent, cells[k].cell);
+    }
+
+    this->agentCells[agent].clear();
+    this->agentCellsBegin[agent] = 0;
+}
+
+void Simulation::updateSubscriptions() {
+    const int numCells = this->graph.getUniformGrid().getNumCells();
+    if (static_cast<int>(this->cellSubscribers.size()) != numCells) {
+        this->cellSubscribers.assign(numCells, {});
+        this->occupiedCells.resize(numCells);
+        this->occupiedCellList.clear();
+    }
+    this->agentCells.resize(this->agents.size());
+    this->agentCellsBegin.resize(this->agents.size(), 0);
+
+    for (int a = 0; a < static_cast<int>(this->agents.size()); a++) {
+        Agent *agent = this->agents[a];
+
+        if (agent->getCurrentId() == agent->getEndId()) {
+            if (!this->agentCells[a].empty()) this->unsubscribe(a);
+            continue;
+        }
+
+        if (agent->consumePathChanged()) {
+            this->unsubscribe(a);
+            this->agentCells[a] = agent->getPathCells();
+            for (const Agent::PathCell &pathCell : this->agentCells[a]) this->subscribeCell(a, pathCell.cell);
+            continue;
+        }
+
+        // Células usadas apenas pelos passos já percorridos deixam de ser acompanhadas
+        const std::vector<Agent::PathCell> &cells = this->agentCells[a];
+        int &begin = this->agentCellsBegin[a];
+        while (begin < static_cast<int>(cells.size()) && cells[begin].lastStep < agent->getPathIndex()) {
+            this->unsubscribeCell(a, cells[begin].cell);
+            begin++;
+        }
+    }
+}
+
+void Simulation::flagConflicts() {
+    const ObstacleSnapshot &obstacles = this->graph.getObstacleSnapshot();
+
+    // Células que deixaram de ser ocupadas
+    for (const int cell : this->occupiedCellList) {
+        if (obstacles.isCellOccupied(cell)) continue;
+
+        this->occupiedCells.reset(cell);
+        for (const int agent : this->cellSubscribers[cell]) this->agents[agent]->addOccupiedPathCells(-1);
+    }
+
+    // Células que passaram a ser ocupadas
+    for (const int cell : obstacles.getOccupiedCells()) {
+        if (this->occupiedCells.test(cell)) continue;
+
+        this->occupiedCells.set(cell);
+        for (const int agent : this->cellSubscribers[cell]) {
+            this->agents[agent]->addOccupiedPathCells(1);
+            this->pathAlerts++;
+        }
+    }
+
+    this->occupiedCellList = obstacles.getOccupiedCells();
+}
+
+bool Simulation::step() {
+    this->graph.updatePolygonsPosition();
+
+    // Fotografia, CCH e landmarks ficam prontos antes, durante o passo dos agentes o grafo é somente leitura
+    this->graph.prepareQueries(this->algorithm);
+    this->flagConflicts();
+
+    this->scheduler.run(static_cast<int>(this->agents.size()), this->numThreads, [this](const int i) {
+        this->agents[i]->move(this->graph);
+    });
+
+    this->ticks++;
+    this->numArrived = 0;
+    for (const Agent *agent : this->agents) {
+        if (agent->getCurrentId() == agent->getEndId()) this->numArrived++;
+    }
+
+    this->updateSubscriptions();
+
+    return this->numArrived < static_cast<int>(this->agents.size());
+}
+
+int Simulation::getNumDynamic() const {
+    int count = 0;
+    for (const Agent *agent : this->agents) {
+        if (agent->getType() == Agent::Dynamic) count++;
+    }
+
+    return count;
+}
+
+long long Simulation::getReplans() const {
+    long long replans = 0;
+    for (const Agent *agent : this->agents) {
+        replans += agent->aStarQnt - 1;
+    }
+
+    return replans;
+}
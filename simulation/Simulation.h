@@ -0,0 +1,67 @@
+#ifndef PROJETOCONCLUSAOCURSO_SIMULATION_H
+#define PROJETOCONCLUSAOCURSO_SIMULATION_H
+#include <vector>
+
+#include "../graph/DynamicGraph.h"
+#include "../helper/Bitmap.h"
+#include "../helper/WorkStealing.h"
+#include "../screen/Agent.h"
+
+
+// Frota de agentes compartilhando os mesmos polígonos em movimento
+// A cada tick os polígonos se movem, a fotografia dos bloqueios é refeita uma única vez e os agentes se movem em
+// paralelo apenas lendo o grafo. Agentes que replanejam custam muito mais que os que seguem na aresta, então
+// a distribuição entre as threads é feita por roubo de trabalho
+// Os agentes dinâmicos ficam inscritos nas células do restante do caminho planejado e só validam o caminho
+// enquanto algum polígono ocupa uma delas. A cada tick apenas os inscritos nas células que passaram a ser (ou
+// deixaram de ser) ocupadas são avisados, então o custo acompanha os conflitos e não o tamanho da frota
+class Simulation {
+    DynamicGraph &graph;
+    DynamicGraph::SearchAlgorithm algorithm;
+    int numThreads;                     // <= 0 usa todas as threads do OpenMP
+    std::vector<Agent*> agents;
+    WorkStealing scheduler;
+    long long ticks = 0;
+    int numArrived = 0;
+
+    std::vector<std::vector<int>> cellSubscribers;  // Célula (índice denso da grade) -> agentes inscritos
+    std::vector<std::vector<Agent::PathCell>> agentCells;   // Células em que cada agente está inscrito
+    std::vector<int> agentCellsBegin;               // Primeira célula ainda inscrita (as anteriores já passaram)
+    Bitmap occupiedCells;                           // Células ocupadas na última chamada de flagConflicts
+    std::vector<int> occupiedCellList;
+    long long pathAlerts = 0;                       // Células do caminho que passaram a ser ocupadas
+
+    void subscribeCell(int agent, int cell);
+    void unsubscribeCell(int agent, int cell);
+    void unsubscribe(int agent);
+    // Reinscreve os agentes que replanejaram, descarta as células já percorridas e remove os que chegaram
+    // (fora da região paralela)
+    void updateSubscriptions();
+    // Avisa os inscritos nas células que passaram a ser ou deixaram de ser ocupadas desde o tick anterior
+    void flagConflicts();
+
+public:
+    Simulation(DynamicGraph &graph, DynamicGraph::SearchAlgorithm algorithm, int numThreads = 0);
+    ~Simulation();
+
+    Simulation(const Simulation &) = delete;
+    Simulation &operator=(const Simulation &) = delete;
+
+    // Adiciona count agentes (fração dynamicShare de dinâmicos) com origem e destino sorteados
+    void addAgents(int count, double dynamicShare, const DistanceMatrix *matrix = nullptr);
+
+    // Executa um tick, retorna se ainda existe algum agente a caminho do destino
+    bool step();
+
+    const std::vector<Agent*> &getAgents() const { return this->agents; }
+    long long getTicks() const { return this->ticks; }
+    int getNumArrived() const { return this->numArrived; }
+    int getNumDynamic() const;
+    // Replanejamentos depois do caminho inicial, somados entre os agentes
+    long long getReplans() const;
+    long long getSteals() const { return this->scheduler.getSteals(); }
+    long long getPathAlerts() const { return this->pathAlerts; }
+};
+
+
+#endif //PROJETOCONCLUSAOCURSO_SIMULATION_H